@@ -0,0 +1,1533 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#ifdef __linux__
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+#endif
+
+#include "gen_defs.h"
+#include "words_grid.h"
+#include "louds_trie.h"
+#include "rack_index.h"
+
+/*
+ BENCHMARK: word list data structures (not part of word_search.exe - built on its own with bench.c instead of main.c)
+
+ usage: bench.exe <base-word-list-file> <variant-word-list-file>
+
+ overlay - memory and batch solve time of a variant word list as a fully merged word list vs. as an overlay
+           (words added/removed) of the base word list; and overlay nodes per changed word and lookup time of words
+           that pass through overlay nodes (near BENCH_OVERLAY_WORDS words removed by an overlay) vs. in the base
+ louds   - memory, word lookup time and grid search time of the base word list as a pointer character tree vs. as a
+           LOUDS trie
+ pattern - word pattern query time of the base word list character tree (and of its suffix order, for a pattern
+           that starts with * and ends with plain characters) vs. a linear scan of its words
+ rack    - rack query time of a rack index of the base word list vs. a linear scan of its words, and the time to find
+           every word of the base word list in a grid (WordsGrid_FindWordId) with vs. without the letter mask prefilter
+ parallel- solve time of one grid (wall clock) by WordsGrid_OutputFoundWords vs. WordsGrid_OutputFoundWordsParallel
+           with 2, 4 and 8 threads (for big grids build with e.g. -DGRID_X_LEN=20 -DGRID_Y_LEN=20)
+ layout  - batch solve time, cache lines touched and cache misses (Linux perf counters, if permitted) of the base
+           word list character nodes in malloc order vs. in one node arena in level order and in profile-guided
+           order (profiled on other grids, saved to a layout file and loaded back)
+ setcell - time of a single cell change of a grid by an incremental re-solve (WordsGrid_SetCell) vs. a full re-solve
+           (WordsGrid_SetGrid and WordsGrid_Solve), checking that both give the same words and score
+ rules   - batch solve time by Boggle rules of the result set (WordsGrid_Solve) vs. the game result
+           (WordsGrid_SolveGame) with and without paths, and with a max length that prunes the search
+ */
+
+#define BENCH_BOARDS		20000
+#define BENCH_RUNS			3		/* best of (alternating runs, to cancel out warm up and noise) */
+#define BENCH_LETTERS		"aeioustrnlpdcmbgh"
+#define BENCH_CELL_CHANGES	2000					/* single cell changes of the setcell random walk */
+#define BENCH_LOUDS_CELLS	(sizeof(unsigned int) * 8)	/* max grid cells of the LOUDS grid search (a used cells bit each) */
+#define BENCH_FIND_GRIDS	100						/* grids to find every word of the word list in */
+#define BENCH_CACHE_LINE	64
+#define BENCH_OVERLAY_WORDS	1000					/* base words removed by the overlay of the overlay lookups */
+#define BENCH_OVERLAY_NEAR	8						/* words looked up before and after every removed word */
+#define BENCH_SAMPLE		(BENCH_BOARDS / 10)		/* grids to profile and to count cache lines of */
+
+/*******************************************************************************************************************************************************/
+/************************************************************ internal functions declation *************************************************************/
+/*******************************************************************************************************************************************************/
+static void benchOutputFunc (char *word);
+static size_t wordListMemory (WordList *word_list);
+static double batchSolve (WordsGrid *words_grid, unsigned long *checksum);
+static RETURN_CODE benchOverlay (WordsGrid *base_grid, WordsGrid *variant_grid);
+static int passesOverlayNode (CharNode *char_tree, const char *word);
+static RETURN_CODE benchOverlayLookup (WordsGrid *base_grid);
+static void searchLoudsFromNode (LoudsTrie *louds_trie, LoudsNode node, const char *grid_string, int cell, char *word, int word_len, unsigned int used_cells);
+static double batchSolveLouds (LoudsTrie *louds_trie, unsigned long *checksum);
+static RETURN_CODE benchLouds (WordsGrid *base_grid);
+static void benchMatchFunc (char *word, unsigned int word_id);
+static RETURN_CODE benchPattern (WordsGrid *base_grid);
+static int rackHasWord (const char *rack, const char *word);
+static double batchFindWords (WordsGrid *words_grid, size_t *no_of_words);
+static RETURN_CODE benchRack (WordsGrid *base_grid);
+static int compareAddresses (const void *address1, const void *address2);
+static double cacheLinesPerGrid (WordsGrid *words_grid);
+static void cacheMisses (WordsGrid *words_grid, long long misses[2]);
+static RETURN_CODE measureLayout (WordsGrid *words_grid, const char *name, unsigned long *checksum);
+static RETURN_CODE benchLayout (WordsGrid *base_grid);
+static double wallClock (void);
+static RETURN_CODE benchParallel (WordsGrid *base_grid);
+static RETURN_CODE benchSetCell (WordsGrid *base_grid);
+static double batchSolveRules (WordsGrid *words_grid, int solve_game, size_t *no_of_words, long *score, RETURN_CODE *ret_code);
+static RETURN_CODE benchRules (WordsGrid *base_grid);
+
+static unsigned long found_checksum;
+
+/* benchmarked word patterns (pattern, min length, max length) */
+static const struct
+{
+	const char *string;
+	size_t min_len;
+	size_t max_len;
+} bench_patterns[] = {{"a?and?n", 0, 0}, {"ab*on", 0, 0}, {"*ing", 5, 7}, {"*ness", 0, 0}, {"[st]?[aeiou]*", 0, 6}, {"q[^u]*", 0, 0}};
+
+/* benchmarked racks */
+static const char *bench_racks[] = {"retains", "qzaeiou", "aeiourstln", "qzxjkaeioubcdfg", "abcdefghijklmno"};
+
+/*******************************************************************************************************************************************************/
+/************************************************************ internal functions definition ************************************************************/
+/*******************************************************************************************************************************************************/
+
+/***********************************************************************************************************************
+ *                                                                                                                     *
+ * FUNCTION: benchOutputFunc                                                                                           *
+ *                                                                                                                     *
+ * DESCRIPTION: output function of benchmarked words grids - sums the found words hashes (so the outputs can be        *
+ *              compared regardless of their order)                                                                    *
+ *                                                                                                                     *
+ * PARAMETERS: word - (in) found word                                                                                  *
+ *                                                                                                                     *
+ * RETURN: none                                                                                                        *
+ *                                                                                                                     *
+ * NOTES:                                                                                                              *
+ *                                                                                                                     *
+ ***********************************************************************************************************************/
+static void benchOutputFunc (char *word)
+{
+	unsigned long hash = 1;
+
+	for (; *word != '\0'; word++)
+	{
+		hash = (hash * 31) + (unsigned char)(*word);
+	}
+	found_checksum += hash;
+}
+
+/***********************************************************************************************************************
+ *                                                                                                                     *
+ * FUNCTION: wordListMemory                                                                                            *
+ *                                                                                                                     *
+ * DESCRIPTION: memory of a word list (character nodes, wide nodes and string table)                                   *
+ *                                                                                                                     *
+ * PARAMETERS: word_list - (in) pointer to word list                                                                   *
+ *                                                                                                                     *
+ * RETURN: memory in bytes                                                                                             *
+ *                                                                                                                     *
+ * NOTES:                                                                                                              *
+ *                                                                                                                     *
+ ***********************************************************************************************************************/
+static size_t wordListMemory (WordList *word_list)
+{
+	return (word_list->allocated_nodes * sizeof(CharNode)) + (word_list->wide_nodes * (sizeof(WideNode) - sizeof(CharNode))) +
+		   word_list->allocated_word_strings + (word_list->allocated_word_offsets * sizeof(unsigned int));
+}
+
+/***********************************************************************************************************************
+ *                                                                                                                     *
+ * FUNCTION: batchSolve                                                                                                *
+ *                                                                                                                     *
+ * DESCRIPTION: output the found words of BENCH_BOARDS random grids (same grids on every call)                         *
+ *                                                                                                                     *
+ * PARAMETERS: words_grid - (in/out) pointer to words grid                                                             *
+ *             checksum - (out) checksum of all found words                                                            *
+ *                                                                                                                     *
+ * RETURN: time per grid in microseconds                                                                               *
+ *                                                                                                                     *
+ * NOTES:                                                                                                              *
+ *                                                                                                                     *
+ ***********************************************************************************************************************/
+static double batchSolve (WordsGrid *words_grid, unsigned long *checksum)
+{
+	char grid_string[GRID_CELLS+1];
+	clock_t start;
+	int i, k;
+
+	srand(1);
+	found_checksum = 0;
+	start = clock();
+
+	for (i = 0; i < BENCH_BOARDS; i++)
+	{
+		for (k = 0; k < GRID_CELLS; k++)
+		{
+			grid_string[k] = BENCH_LETTERS[rand() % (sizeof(BENCH_LETTERS)-1)];
+		}
+		grid_string[GRID_CELLS] = '\0';
+
+		WordsGrid_SetGrid(words_grid, grid_string);
+		WordsGrid_OutputFoundWords(words_grid);
+	}
+
+	*checksum = found_checksum;
+
+	return ((double)(clock() - start) / CLOCKS_PER_SEC) * 1e6 / BENCH_BOARDS;
+}
+
+/***********************************************************************************************************************
+ *                                                                                                                     *
+ * FUNCTION: benchOverlay                                                                                              *
+ *                                                                                                                     *
+ * DESCRIPTION: compare a variant word list (fully merged) with an overlay of the base word list holding the           *
+ *              same words                                                                                             *
+ *                                                                                                                     *
+ * PARAMETERS: base_grid - (in/out) words grid of the base word list                                                   *
+ *             variant_grid - (in/out) words grid of the variant word list                                             *
+ *                                                                                                                     *
+ * RETURN: RC_NO_ERROR - no error                                                                                      *
+ *         RC_NO_MEM - no memory                                                                                       *
+ *                                                                                                                     *
+ * NOTES:                                                                                                              *
+ *                                                                                                                     *
+ ***********************************************************************************************************************/
+static RETURN_CODE benchOverlay (WordsGrid *base_grid, WordsGrid *variant_grid)
+{
+	WordList *base = &(base_grid->word_list);
+	WordList *variant = &(variant_grid->word_list);
+	WordListOverlay overlay;
+	unsigned long merged_checksum, overlay_checksum;
+	double merged_time = 0, overlay_time = 0, run_time;
+	size_t overlay_memory;
+	unsigned int word_id;
+	int run;
+	RETURN_CODE ret_code = RC_NO_ERROR;
+
+	/* overlay = variant words not in base (added) + base words not in variant (removed) */
+	WordListOverlay_Init(&overlay, base);
+	for (word_id = 0; (word_id < variant->no_of_words) && (ret_code == RC_NO_ERROR); word_id++)
+	{
+		ret_code = WordListOverlay_AddWord(&overlay, WordList_GetWord(variant, word_id));
+	}
+	for (word_id = 0; (word_id < base->no_of_words) && (ret_code == RC_NO_ERROR); word_id++)
+	{
+		if (WordList_FindWord(variant->char_tree, WordList_GetWord(base, word_id)) != WORD_FOUND)
+		{
+			ret_code = WordListOverlay_RemoveWord(&overlay, WordList_GetWord(base, word_id));
+		}
+	}
+
+	if (ret_code == RC_NO_ERROR)
+	{
+		overlay_memory = (overlay.allocated_nodes * sizeof(CharNode*)) + (overlay.no_of_nodes * sizeof(CharNode)) +
+						 wordListMemory(&(overlay.added_words));
+
+		WordsGrid_SetOverlay(base_grid, &overlay);
+		for (run = 0; run < BENCH_RUNS; run++)
+		{
+			run_time = batchSolve(variant_grid, &merged_checksum);
+			merged_time = ((run == 0) || (run_time < merged_time))? run_time: merged_time;
+
+			run_time = batchSolve(base_grid, &overlay_checksum);
+			overlay_time = ((run == 0) || (run_time < overlay_time))? run_time: overlay_time;
+		}
+		WordsGrid_SetOverlay(base_grid, NULL);
+
+		printf("overlay: %lu words added, %lu words removed\n", (unsigned long)overlay.added_words.no_of_words,
+			   (unsigned long)overlay.no_of_removed_words);
+		printf("  merged word list:  %lu nodes, %lu bytes, %.2f us/grid\n", (unsigned long)variant->allocated_nodes,
+			   (unsigned long)wordListMemory(variant), merged_time);
+		printf("  base + overlay:    %lu nodes, %lu bytes (delta only), %.2f us/grid%s\n", (unsigned long)overlay.no_of_nodes,
+			   (unsigned long)overlay_memory, overlay_time, (overlay_checksum == merged_checksum)? "": " (OUTPUT MISMATCH)");
+	}
+
+	WordListOverlay_Free(&overlay);
+
+	return ret_code;
+}
+
+/***********************************************************************************************************************
+ *                                                                                                                     *
+ * FUNCTION: passesOverlayNode                                                                                         *
+ *                                                                                                                     *
+ * DESCRIPTION: does the path of a word (or of its longest prefix) in a character tree pass through an overlay node    *
+ *                                                                                                                     *
+ * PARAMETERS: char_tree - (in) pointer to character tree (of a word list overlay)                                     *
+ *             word - (in) word                                                                                        *
+ *                                                                                                                     *
+ * RETURN: 1 - yes, 0 - no                                                                                             *
+ *                                                                                                                     *
+ * NOTES:                                                                                                              *
+ *                                                                                                                     *
+ ***********************************************************************************************************************/
+static int passesOverlayNode (CharNode *char_tree, const char *word)
+{
+	CharNode *char_node;
+
+	for (; *word != '\0'; word++)
+	{
+		char_node = WordList_FindChar(char_tree, *word);
+		if (char_node == NULL)
+		{
+			break;
+		}
+		if (char_node->flags & NODE_OVERLAY)
+		{
+			return 1;
+		}
+		char_tree = char_node->next;
+	}
+
+	return 0;
+}
+
+/***********************************************************************************************************************
+ *                                                                                                                     *
+ * FUNCTION: benchOverlayLookup                                                                                        *
+ *                                                                                                                     *
+ * DESCRIPTION: compare word lookups in an overlay that removes BENCH_OVERLAY_WORDS words spread over the base word    *
+ *              list with lookups in the base word list - of the words near the removed words (by word ID), whose      *
+ *              paths share the overlay copies                                                                         *
+ *                                                                                                                     *
+ * PARAMETERS: base_grid - (in) words grid of the base word list                                                       *
+ *                                                                                                                     *
+ * RETURN: RC_NO_ERROR - no error                                                                                      *
+ *         RC_NO_MEM - no memory                                                                                       *
+ *                                                                                                                     *
+ * NOTES: the overlay finds every looked up word of the base word list but the removed words; the overlay memory per   *
+ *        changed word is printed too (the overlay copies the sibling nodes before a changed node)                     *
+ *                                                                                                                     *
+ ***********************************************************************************************************************/
+static RETURN_CODE benchOverlayLookup (WordsGrid *base_grid)
+{
+	WordList *base = &(base_grid->word_list);
+	WordListOverlay overlay;
+	CharNode *char_trees[2];
+	unsigned int *lookups;
+	size_t no_of_lookups = 0, overlay_lookups = 0, found[2] = {0}, step, k;
+	double times[2] = {0}, run_time;
+	unsigned int word_id, first, last;
+	clock_t start;
+	int run, t;
+	RETURN_CODE ret_code = RC_NO_ERROR;
+
+	step = base->no_of_words / BENCH_OVERLAY_WORDS;
+	if (step <= (2 * BENCH_OVERLAY_NEAR))
+	{
+		/* a base word list too small to spread the removed words over */
+		return RC_NO_ERROR;
+	}
+
+	lookups = (unsigned int*)malloc(BENCH_OVERLAY_WORDS * ((2 * BENCH_OVERLAY_NEAR) + 1) * sizeof(unsigned int));
+	if (lookups == NULL)
+	{
+		return RC_NO_MEM;
+	}
+
+	/* remove a word in the middle of every step - and look up the words around it (and the word itself) */
+	WordListOverlay_Init(&overlay, base);
+	for (k = 0; (k < BENCH_OVERLAY_WORDS) && (ret_code == RC_NO_ERROR); k++)
+	{
+		word_id = (unsigned int)((k * step) + (step / 2));
+		ret_code = WordListOverlay_RemoveWord(&overlay, WordList_GetWord(base, word_id));
+
+		first = word_id - BENCH_OVERLAY_NEAR;
+		last = word_id + BENCH_OVERLAY_NEAR;
+		for (word_id = first; word_id <= last; word_id++)
+		{
+			lookups[no_of_lookups++] = word_id;
+		}
+	}
+
+	if (ret_code == RC_NO_ERROR)
+	{
+		for (k = 0; k < no_of_lookups; k++)
+		{
+			overlay_lookups += passesOverlayNode(overlay.char_tree, WordList_GetWord(base, lookups[k]));
+		}
+
+		char_trees[0] = base->char_tree;
+		char_trees[1] = overlay.char_tree;
+		for (run = 0; run < BENCH_RUNS; run++)
+		{
+			for (t = 0; t < 2; t++)
+			{
+				found[t] = 0;
+				start = clock();
+				for (k = 0; k < no_of_lookups; k++)
+				{
+					found[t] += (WordList_FindWord(char_trees[t], WordList_GetWord(base, lookups[k])) == WORD_FOUND);
+				}
+				run_time = ((double)(clock() - start) / CLOCKS_PER_SEC) * 1e9 / no_of_lookups;
+				times[t] = ((run == 0) || (run_time < times[t]))? run_time: times[t];
+			}
+		}
+
+		printf("overlay lookup: %lu words removed (spread over the base word list)\n", (unsigned long)overlay.no_of_removed_words);
+		printf("  overlay:           %lu nodes, %.1f nodes (%lu bytes) per changed word\n", (unsigned long)overlay.no_of_nodes,
+			   (double)overlay.no_of_nodes / overlay.no_of_removed_words,
+			   (unsigned long)(((overlay.allocated_nodes * sizeof(CharNode*)) + (overlay.no_of_nodes * sizeof(CharNode))) / overlay.no_of_removed_words));
+		printf("  %lu lookups (%lu through overlay nodes): base %.1f ns/word, base + overlay %.1f ns/word%s\n",
+			   (unsigned long)no_of_lookups, (unsigned long)overlay_lookups, times[0], times[1],
+			   (found[1] + overlay.no_of_removed_words == found[0])? "": " (LOOKUP MISMATCH)");
+	}
+
+	WordListOverlay_Free(&overlay);
+	free(lookups);
+
+	return ret_code;
+}
+
+/***********************************************************************************************************************
+ *                                                                                                                     *
+ * FUNCTION: searchLoudsFromNode                                                                                       *
+ *                                                                                                                     *
+ * DESCRIPTION: output all words of a LOUDS trie found in a grid from a prefix (the grid search of words_grid.c        *
+ *              with LOUDS trie steps)                                                                                 *
+ *                                                                                                                     *
+ * PARAMETERS: louds_trie - (in) pointer to LOUDS trie                                                                 *
+ *             node - (in) node of the prefix                                                                          *
+ *             grid_string - (in) grid (cell index order)                                                              *
+ *             cell - (in) last cell of the prefix                                                                     *
+ *             word, word_len - (in) prefix characters                                                                 *
+ *             used_cells - (in) cells of the prefix (bit per cell)                                                    *
+ *                                                                                                                     *
+ * RETURN: none                                                                                                        *
+ *                                                                                                                     *
+ * NOTES:                                                                                                              *
+ *                                                                                                                     *
+ ***********************************************************************************************************************/
+static void searchLoudsFromNode (LoudsTrie *louds_trie, LoudsNode node, const char *grid_string, int cell, char *word, int word_len, unsigned int used_cells)
+{
+	LoudsNode next_node;
+	int x, y, next_x, next_y, next_cell;
+
+	if (LoudsTrie_IsWord(louds_trie, node))
+	{
+		word[word_len] = '\0';
+		benchOutputFunc(word);
+	}
+
+	if (!LoudsTrie_HasChildren(louds_trie, node))
+	{
+		return;
+	}
+
+	x = cell / GRID_Y_LEN;
+	y = cell % GRID_Y_LEN;
+	for (next_x = x - 1; next_x <= x + 1; next_x++)
+	{
+		for (next_y = y - 1; next_y <= y + 1; next_y++)
+		{
+			next_cell = (next_x * GRID_Y_LEN) + next_y;
+			if ((next_x < 0) || (next_x >= GRID_X_LEN) || (next_y < 0) || (next_y >= GRID_Y_LEN) || (used_cells & (1u << next_cell)))
+			{
+				continue;
+			}
+
+			next_node = LoudsTrie_FindChar(louds_trie, node, grid_string[next_cell]);
+			if (next_node != LOUDS_NO_NODE)
+			{
+				word[word_len] = grid_string[next_cell];
+				searchLoudsFromNode(louds_trie, next_node, grid_string, next_cell, word, word_len + 1, used_cells | (1u << next_cell));
+			}
+		}
+	}
+}
+
+/***********************************************************************************************************************
+ *                                                                                                                     *
+ * FUNCTION: batchSolveLouds                                                                                           *
+ *                                                                                                                     *
+ * DESCRIPTION: output the found words of a LOUDS trie in the grids of batchSolve                                      *
+ *                                                                                                                     *
+ * PARAMETERS: louds_trie - (in) pointer to LOUDS trie                                                                 *
+ *             checksum - (out) checksum of all found words                                                            *
+ *                                                                                                                     *
+ * RETURN: time per grid in microseconds                                                                               *
+ *                                                                                                                     *
+ * NOTES:                                                                                                              *
+ *                                                                                                                     *
+ ***********************************************************************************************************************/
+static double batchSolveLouds (LoudsTrie *louds_trie, unsigned long *checksum)
+{
+	char grid_string[GRID_CELLS+1];
+	char word[GRID_CELLS+1];
+	LoudsNode node;
+	clock_t start;
+	int i, k;
+
+	srand(1);
+	found_checksum = 0;
+	start = clock();
+
+	for (i = 0; i < BENCH_BOARDS; i++)
+	{
+		for (k = 0; k < GRID_CELLS; k++)
+		{
+			grid_string[k] = BENCH_LETTERS[rand() % (sizeof(BENCH_LETTERS)-1)];
+		}
+		grid_string[GRID_CELLS] = '\0';
+
+		for (k = 0; k < GRID_CELLS; k++)
+		{
+			node = LoudsTrie_FindChar(louds_trie, 0, grid_string[k]);
+			if (node != LOUDS_NO_NODE)
+			{
+				word[0] = grid_string[k];
+				searchLoudsFromNode(louds_trie, node, grid_string, k, word, 1, 1u << k);
+			}
+		}
+	}
+
+	*checksum = found_checksum;
+
+	return ((double)(clock() - start) / CLOCKS_PER_SEC) * 1e6 / BENCH_BOARDS;
+}
+
+/***********************************************************************************************************************
+ *                                                                                                                     *
+ * FUNCTION: benchLouds                                                                                                *
+ *                                                                                                                     *
+ * DESCRIPTION: compare the base word list character tree with a LOUDS trie of the same words                          *
+ *                                                                                                                     *
+ * PARAMETERS: base_grid - (in/out) words grid of the base word list                                                   *
+ *                                                                                                                     *
+ * RETURN: RC_NO_ERROR - no error                                                                                      *
+ *         RC_NO_MEM - no memory                                                                                       *
+ *                                                                                                                     *
+ * NOTES: the grid search of a LOUDS trie uses a bit per cell and so is for grids of up to BENCH_LOUDS_CELLS cells     *
+ *                                                                                                                     *
+ ***********************************************************************************************************************/
+static RETURN_CODE benchLouds (WordsGrid *base_grid)
+{
+	WordList *base = &(base_grid->word_list);
+	LoudsTrie louds_trie;
+	unsigned long tree_checksum = 0, louds_checksum = 0, tree_found = 0, louds_found = 0;
+	double tree_time = 0, louds_time = 0, tree_lookup, louds_lookup, run_time;
+	char tree_grid[32] = "n/a", louds_grid[32] = "n/a";
+	clock_t start;
+	unsigned int word_id;
+	int run;
+	RETURN_CODE ret_code;
+
+	ret_code = LoudsTrie_Build(&louds_trie, base);
+	if (ret_code != RC_NO_ERROR)
+	{
+		return ret_code;
+	}
+
+	/* word lookups: every word of the word list */
+	start = clock();
+	for (word_id = 0; word_id < base->no_of_words; word_id++)
+	{
+		tree_found += (WordList_FindWord(base->char_tree, WordList_GetWord(base, word_id)) == WORD_FOUND);
+	}
+	tree_lookup = ((double)(clock() - start) / CLOCKS_PER_SEC) * 1e9 / base->no_of_words;
+
+	start = clock();
+	for (word_id = 0; word_id < base->no_of_words; word_id++)
+	{
+		louds_found += (LoudsTrie_FindWord(&louds_trie, WordList_GetWord(base, word_id)) == WORD_FOUND);
+	}
+	louds_lookup = ((double)(clock() - start) / CLOCKS_PER_SEC) * 1e9 / base->no_of_words;
+
+	/* grid search: only for grids of up to BENCH_LOUDS_CELLS cells ("n/a" for bigger grids) */
+	for (run = 0; (run < BENCH_RUNS) && (GRID_CELLS <= BENCH_LOUDS_CELLS); run++)
+	{
+		run_time = batchSolve(base_grid, &tree_checksum);
+		tree_time = ((run == 0) || (run_time < tree_time))? run_time: tree_time;
+
+		run_time = batchSolveLouds(&louds_trie, &louds_checksum);
+		louds_time = ((run == 0) || (run_time < louds_time))? run_time: louds_time;
+
+		sprintf(tree_grid, "%.2f", tree_time);
+		sprintf(louds_grid, "%.2f", louds_time);
+	}
+
+	printf("louds: %lu nodes, %lu words\n", (unsigned long)(louds_trie.no_of_nodes - 1), (unsigned long)louds_trie.no_of_words);
+	printf("  character tree:    %lu bytes (+ malloc overhead per node), %.1f ns/lookup, %s us/grid\n",
+		   (unsigned long)((base->allocated_nodes * sizeof(CharNode)) + (base->wide_nodes * (sizeof(WideNode) - sizeof(CharNode)))),
+		   tree_lookup, tree_grid);
+	printf("  LOUDS trie:        %lu bytes (%.1f bits/node), %.1f ns/lookup, %s us/grid%s\n", (unsigned long)LoudsTrie_Memory(&louds_trie),
+		   (8.0 * LoudsTrie_Memory(&louds_trie)) / (louds_trie.no_of_nodes - 1), louds_lookup, louds_grid,
+		   ((louds_found == tree_found) && (louds_checksum == tree_checksum))? "": " (OUTPUT MISMATCH)");
+
+	LoudsTrie_Free(&louds_trie);
+
+	return RC_NO_ERROR;
+}
+
+/***********************************************************************************************************************
+ *                                                                                                                     *
+ * FUNCTION: benchMatchFunc                                                                                            *
+ *                                                                                                                     *
+ * DESCRIPTION: match function of benchmarked word pattern queries                                                     *
+ *                                                                                                                     *
+ * PARAMETERS: word - (in) matching word                                                                               *
+ *             word_id - (in) word ID                                                                                  *
+ *                                                                                                                     *
+ * RETURN: none                                                                                                        *
+ *                                                                                                                     *
+ * NOTES:                                                                                                              *
+ *                                                                                                                     *
+ ***********************************************************************************************************************/
+static void benchMatchFunc (char *word, unsigned int word_id)
+{
+	(void)word_id;
+
+	benchOutputFunc(word);
+}
+
+/***********************************************************************************************************************
+ *                                                                                                                     *
+ * FUNCTION: benchPattern                                                                                              *
+ *                                                                                                                     *
+ * DESCRIPTION: compare word pattern queries on the base word list character tree (and on its suffix order) with a     *
+ *              linear scan of its words                                                                               *
+ *                                                                                                                     *
+ * PARAMETERS: base_grid - (in) words grid of the base word list                                                       *
+ *                                                                                                                     *
+ * RETURN: RC_NO_ERROR - no error                                                                                      *
+ *         RC_BAD_FORMAT - bad benchmarked pattern                                                                     *
+ *         RC_NO_MEM - no memory (for the suffix order)                                                                *
+ *                                                                                                                     *
+ * NOTES: the linear scan matches the words of the word list string table (in memory) one by one                       *
+ *                                                                                                                     *
+ ***********************************************************************************************************************/
+static RETURN_CODE benchPattern (WordsGrid *base_grid)
+{
+	WordList *base = &(base_grid->word_list);
+	WordPattern pattern;
+	unsigned long tree_checksum, suffix_checksum, scan_checksum;
+	double tree_time, suffix_time, scan_time;
+	char suffix_us[32];
+	size_t no_of_matches, k;
+	unsigned int word_id;
+	clock_t start;
+	int run;
+
+	if (WordList_BuildSuffixOrder(base) != RC_NO_ERROR)
+	{
+		return RC_NO_MEM;
+	}
+
+	printf("pattern:\n");
+
+	for (k = 0; k < (sizeof(bench_patterns) / sizeof(bench_patterns[0])); k++)
+	{
+		if (WordList_CompilePattern(&pattern, bench_patterns[k].string, bench_patterns[k].min_len, bench_patterns[k].max_len) != RC_NO_ERROR)
+		{
+			return RC_BAD_FORMAT;
+		}
+
+		found_checksum = 0;
+		start = clock();
+		for (run = 0; run < BENCH_RUNS; run++)
+		{
+			no_of_matches = WordList_FindPattern(base->char_tree, &pattern, 0, benchMatchFunc);
+		}
+		tree_time = ((double)(clock() - start) / CLOCKS_PER_SEC) * 1e6 / BENCH_RUNS;
+		tree_checksum = found_checksum;
+
+		found_checksum = 0;
+		start = clock();
+		for (run = 0; run < BENCH_RUNS; run++)
+		{
+			WordList_FindPatternBySuffix(base, &pattern, 0, benchMatchFunc);
+		}
+		suffix_time = ((double)(clock() - start) / CLOCKS_PER_SEC) * 1e6 / BENCH_RUNS;
+		suffix_checksum = found_checksum;
+
+		found_checksum = 0;
+		start = clock();
+		for (run = 0; run < BENCH_RUNS; run++)
+		{
+			for (word_id = 0; word_id < base->no_of_words; word_id++)
+			{
+				if (WordList_MatchPattern(&pattern, WordList_GetWord(base, word_id)))
+				{
+					benchOutputFunc(WordList_GetWord(base, word_id));
+				}
+			}
+		}
+		scan_time = ((double)(clock() - start) / CLOCKS_PER_SEC) * 1e6 / BENCH_RUNS;
+		scan_checksum = found_checksum;
+
+		/* other patterns are found on the character tree by WordList_FindPatternBySuffix too */
+		strcpy(suffix_us, "n/a");
+		if ((pattern.any_chars_states & 1) && (pattern.suffix_len != 0))
+		{
+			sprintf(suffix_us, "%.1f us (x%.1f)", suffix_time, (suffix_time > 0)? (scan_time / suffix_time): 0.0);
+		}
+
+		printf("  %-16s [%lu..%lu] %6lu matches: character tree %9.1f us (x%.1f), suffix order %s, linear scan %9.1f us%s\n",
+			   bench_patterns[k].string, (unsigned long)pattern.min_len, (unsigned long)pattern.max_len, (unsigned long)no_of_matches,
+			   tree_time, (tree_time > 0)? (scan_time / tree_time): 0.0, suffix_us, scan_time,
+			   ((tree_checksum == scan_checksum) && (suffix_checksum == scan_checksum))? "": " (OUTPUT MISMATCH)");
+	}
+
+	return RC_NO_ERROR;
+}
+
+/***********************************************************************************************************************
+ *                                                                                                                     *
+ * FUNCTION: rackHasWord                                                                                               *
+ *                                                                                                                     *
+ * DESCRIPTION: can a word be built from a rack (linear scan check)                                                    *
+ *                                                                                                                     *
+ * PARAMETERS: rack - (in) rack letters                                                                                *
+ *             word - (in) word                                                                                        *
+ *                                                                                                                     *
+ * RETURN: 1 - yes, 0 - no                                                                                             *
+ *                                                                                                                     *
+ * NOTES:                                                                                                              *
+ *                                                                                                                     *
+ ***********************************************************************************************************************/
+static int rackHasWord (const char *rack, const char *word)
+{
+	int counts[256] = {0};
+
+	for (; *rack != '\0'; rack++)
+	{
+		counts[(unsigned char)(*rack)]++;
+	}
+
+	for (; *word != '\0'; word++)
+	{
+		if (--counts[(unsigned char)(*word)] < 0)
+		{
+			return 0;
+		}
+	}
+
+	return 1;
+}
+
+/***********************************************************************************************************************
+ *                                                                                                                     *
+ * FUNCTION: batchFindWords                                                                                            *
+ *                                                                                                                     *
+ * DESCRIPTION: find every word of the words grid word list (by word ID) in BENCH_FIND_GRIDS random grids (same grids  *
+ *              on every call)                                                                                         *
+ *                                                                                                                     *
+ * PARAMETERS: words_grid - (in/out) pointer to words grid                                                             *
+ *             no_of_words - (out) total number of words found                                                         *
+ *                                                                                                                     *
+ * RETURN: time per grid in microseconds                                                                               *
+ *                                                                                                                     *
+ * NOTES:                                                                                                              *
+ *                                                                                                                     *
+ ***********************************************************************************************************************/
+static double batchFindWords (WordsGrid *words_grid, size_t *no_of_words)
+{
+	char grid_string[GRID_CELLS+1];
+	CellIndex path[MAX_PATH_LEN];
+	unsigned int word_id;
+	clock_t start;
+	int i, k;
+
+	srand(1);
+	*no_of_words = 0;
+	start = clock();
+
+	for (i = 0; i < BENCH_FIND_GRIDS; i++)
+	{
+		for (k = 0; k < GRID_CELLS; k++)
+		{
+			grid_string[k] = BENCH_LETTERS[rand() % (sizeof(BENCH_LETTERS)-1)];
+		}
+		grid_string[GRID_CELLS] = '\0';
+		WordsGrid_SetGrid(words_grid, grid_string);
+
+		for (word_id = 0; word_id < words_grid->word_list.no_of_words; word_id++)
+		{
+			if (WordsGrid_FindWordId(words_grid, word_id, path) != 0)
+			{
+				(*no_of_words)++;
+			}
+		}
+	}
+
+	return ((double)(clock() - start) / CLOCKS_PER_SEC) * 1e6 / BENCH_FIND_GRIDS;
+}
+
+/***********************************************************************************************************************
+ *                                                                                                                     *
+ * FUNCTION: benchRack                                                                                                 *
+ *                                                                                                                     *
+ * DESCRIPTION: compare rack queries on a rack index of the base word list with a linear scan of its words, and        *
+ *              finding words in a grid with and without the word letter mask prefilter                                *
+ *                                                                                                                     *
+ * PARAMETERS: base_grid - (in/out) words grid of the base word list                                                   *
+ *                                                                                                                     *
+ * RETURN: RC_NO_ERROR - no error                                                                                      *
+ *         RC_NO_MEM - no memory                                                                                       *
+ *                                                                                                                     *
+ * NOTES:                                                                                                              *
+ *                                                                                                                     *
+ ***********************************************************************************************************************/
+static RETURN_CODE benchRack (WordsGrid *base_grid)
+{
+	WordList *base = &(base_grid->word_list);
+	RackIndex rack_index;
+	unsigned long index_checksum, scan_checksum;
+	double index_time, scan_time;
+	size_t no_of_words = 0, no_of_found_words, k;
+	unsigned int word_id;
+	clock_t start;
+	int run;
+	RETURN_CODE ret_code;
+
+	start = clock();
+	ret_code = RackIndex_Build(&rack_index, base);
+	if (ret_code != RC_NO_ERROR)
+	{
+		return ret_code;
+	}
+
+	printf("rack: index of %lu letter masks built in %.1f ms\n", (unsigned long)rack_index.no_of_buckets,
+		   ((double)(clock() - start) / CLOCKS_PER_SEC) * 1e3);
+
+	for (k = 0; k < (sizeof(bench_racks) / sizeof(bench_racks[0])); k++)
+	{
+		start = clock();
+		for (run = 0; run < (100 * BENCH_RUNS); run++)
+		{
+			found_checksum = 0;
+			no_of_words = RackIndex_FindWords(&rack_index, bench_racks[k], 0, benchMatchFunc);
+		}
+		index_time = ((double)(clock() - start) / CLOCKS_PER_SEC) * 1e6 / (100 * BENCH_RUNS);
+		index_checksum = found_checksum;
+
+		found_checksum = 0;
+		start = clock();
+		for (word_id = 0; word_id < base->no_of_words; word_id++)
+		{
+			if (rackHasWord(bench_racks[k], WordList_GetWord(base, word_id)))
+			{
+				benchOutputFunc(WordList_GetWord(base, word_id));
+			}
+		}
+		scan_time = ((double)(clock() - start) / CLOCKS_PER_SEC) * 1e6;
+		scan_checksum = found_checksum;
+
+		printf("  %-16s %6lu words: rack index %9.1f us, linear scan %9.1f us%s\n", bench_racks[k], (unsigned long)no_of_words,
+			   index_time, scan_time, (index_checksum == scan_checksum)? "": " (OUTPUT MISMATCH)");
+	}
+
+	/* grid prefilter: words with a letter not in grid are rejected by their word letter masks */
+	WordsGrid_SetRackIndex(base_grid, &rack_index);
+	index_time = batchFindWords(base_grid, &no_of_found_words);
+	WordsGrid_SetRackIndex(base_grid, NULL);
+	scan_time = batchFindWords(base_grid, &no_of_words);
+
+	printf("  find all words in grid %6.1f words/grid: mask prefilter %9.1f us, path search only %9.1f us%s\n",
+		   (double)no_of_found_words / BENCH_FIND_GRIDS, index_time, scan_time, (no_of_found_words == no_of_words)? "": " (OUTPUT MISMATCH)");
+
+	RackIndex_Free(&rack_index);
+
+	return RC_NO_ERROR;
+}
+
+/***********************************************************************************************************************
+ *                                                                                                                     *
+ * FUNCTION: compareAddresses                                                                                          *
+ *                                                                                                                     *
+ * DESCRIPTION: qsort compare function of cache line addresses                                                         *
+ *                                                                                                                     *
+ * PARAMETERS: address1, address2 - (in) pointers to addresses                                                         *
+ *                                                                                                                     *
+ * RETURN: <0, 0, >0                                                                                                   *
+ *                                                                                                                     *
+ * NOTES:                                                                                                              *
+ *                                                                                                                     *
+ ***********************************************************************************************************************/
+static int compareAddresses (const void *address1, const void *address2)
+{
+	size_t a1 = *(const size_t*)address1;
+	size_t a2 = *(const size_t*)address2;
+
+	return (a1 > a2) - (a1 < a2);
+}
+
+/***********************************************************************************************************************
+ *                                                                                                                     *
+ * FUNCTION: cacheLinesPerGrid                                                                                         *
+ *                                                                                                                     *
+ * DESCRIPTION: average number of distinct cache lines of the character nodes found in a grid (of word and prefix      *
+ *              paths) over the first BENCH_SAMPLE batchSolve grids - the fewer lines, the fewer cache misses of the   *
+ *              grid search                                                                                            *
+ *                                                                                                                     *
+ * PARAMETERS: words_grid - (in/out) pointer to words grid                                                             *
+ *                                                                                                                     *
+ * RETURN: cache lines per grid (or -1 if no memory)                                                                   *
+ *                                                                                                                     *
+ * NOTES: a software measure of locality (works where cache miss counters are not permitted)                           *
+ *                                                                                                                     *
+ ***********************************************************************************************************************/
+static double cacheLinesPerGrid (WordsGrid *words_grid)
+{
+	char grid_string[GRID_CELLS+1];
+	size_t *lines = NULL, *new_lines, allocated_lines = 0, no_of_lines, total_lines = 0, k;
+	int i, c;
+
+	srand(1);
+	for (i = 0; i < BENCH_SAMPLE; i++)
+	{
+		for (c = 0; c < GRID_CELLS; c++)
+		{
+			grid_string[c] = BENCH_LETTERS[rand() % (sizeof(BENCH_LETTERS)-1)];
+		}
+		grid_string[GRID_CELLS] = '\0';
+
+		WordsGrid_SetGrid(words_grid, grid_string);
+		if (WordsGrid_Solve(words_grid) != RC_NO_ERROR)
+		{
+			free(lines);
+			return -1;
+		}
+
+		if (words_grid->result_set.no_of_found_paths > allocated_lines)
+		{
+			allocated_lines = 2 * words_grid->result_set.no_of_found_paths;
+			new_lines = (size_t*)realloc(lines, allocated_lines * sizeof(size_t));
+			if (new_lines == NULL)
+			{
+				free(lines);
+				return -1;
+			}
+			lines = new_lines;
+		}
+
+		for (k = 0; k < words_grid->result_set.no_of_found_paths; k++)
+		{
+			lines[k] = (size_t)(words_grid->result_set.found_paths[k].char_node) / BENCH_CACHE_LINE;
+		}
+		qsort(lines, words_grid->result_set.no_of_found_paths, sizeof(size_t), compareAddresses);
+
+		for (k = 0, no_of_lines = 0; k < words_grid->result_set.no_of_found_paths; k++)
+		{
+			no_of_lines += ((k == 0) || (lines[k] != lines[k - 1]));
+		}
+		total_lines += no_of_lines;
+	}
+
+	free(lines);
+
+	return (double)total_lines / BENCH_SAMPLE;
+}
+
+/***********************************************************************************************************************
+ *                                                                                                                     *
+ * FUNCTION: cacheMisses                                                                                               *
+ *                                                                                                                     *
+ * DESCRIPTION: L1 data cache and last level cache read misses of a batch solve (Linux perf counters)                  *
+ *                                                                                                                     *
+ * PARAMETERS: words_grid - (in/out) pointer to words grid                                                             *
+ *             misses - (out) L1D and LLC read misses (-1 if not counted)                                              *
+ *                                                                                                                     *
+ * RETURN: none                                                                                                        *
+ *                                                                                                                     *
+ * NOTES: perf counters are not permitted in every environment (e.g. containers, perf_event_paranoid)                  *
+ *                                                                                                                     *
+ ***********************************************************************************************************************/
+static void cacheMisses (WordsGrid *words_grid, long long misses[2])
+{
+	unsigned long checksum;
+#ifdef __linux__
+	static const unsigned long long configs[2] = {
+		PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16),
+		PERF_COUNT_HW_CACHE_LL | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16)};
+	struct perf_event_attr attr;
+	int fds[2], k;
+
+	for (k = 0; k < 2; k++)
+	{
+		memset(&attr, 0, sizeof(attr));
+		attr.type = PERF_TYPE_HW_CACHE;
+		attr.size = sizeof(attr);
+		attr.config = configs[k];
+		attr.disabled = 1;
+		attr.exclude_kernel = 1;
+		attr.exclude_hv = 1;
+		fds[k] = (int)syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+		if (fds[k] >= 0)
+		{
+			ioctl(fds[k], PERF_EVENT_IOC_RESET, 0);
+			ioctl(fds[k], PERF_EVENT_IOC_ENABLE, 0);
+		}
+	}
+
+	batchSolve(words_grid, &checksum);
+
+	for (k = 0; k < 2; k++)
+	{
+		misses[k] = -1;
+		if (fds[k] >= 0)
+		{
+			ioctl(fds[k], PERF_EVENT_IOC_DISABLE, 0);
+			if (read(fds[k], &(misses[k]), sizeof(long long)) != sizeof(long long))
+			{
+				misses[k] = -1;
+			}
+			close(fds[k]);
+		}
+	}
+#else
+	batchSolve(words_grid, &checksum);
+	misses[0] = -1;
+	misses[1] = -1;
+#endif
+}
+
+/***********************************************************************************************************************
+ *                                                                                                                     *
+ * FUNCTION: measureLayout                                                                                             *
+ *                                                                                                                     *
+ * DESCRIPTION: measure and print batch solve time, cache lines per grid and cache misses of the current layout of     *
+ *              a words grid word list                                                                                 *
+ *                                                                                                                     *
+ * PARAMETERS: words_grid - (in/out) pointer to words grid                                                             *
+ *             name - (in) layout name                                                                                 *
+ *             checksum - (out) checksum of all found words                                                            *
+ *                                                                                                                     *
+ * RETURN: RC_NO_ERROR - no error                                                                                      *
+ *         RC_NO_MEM - no memory                                                                                       *
+ *                                                                                                                     *
+ * NOTES:                                                                                                              *
+ *                                                                                                                     *
+ ***********************************************************************************************************************/
+static RETURN_CODE measureLayout (WordsGrid *words_grid, const char *name, unsigned long *checksum)
+{
+	double solve_time = 0, run_time, lines;
+	long long misses[2];
+	char l1d[32] = "n/a", llc[32] = "n/a";
+	int run;
+
+	for (run = 0; run < BENCH_RUNS; run++)
+	{
+		run_time = batchSolve(words_grid, checksum);
+		solve_time = ((run == 0) || (run_time < solve_time))? run_time: solve_time;
+	}
+
+	lines = cacheLinesPerGrid(words_grid);
+	if (lines < 0)
+	{
+		return RC_NO_MEM;
+	}
+
+	cacheMisses(words_grid, misses);
+	if (misses[0] >= 0)
+	{
+		sprintf(l1d, "%.0f", (double)misses[0] / BENCH_BOARDS);
+	}
+	if (misses[1] >= 0)
+	{
+		sprintf(llc, "%.1f", (double)misses[1] / BENCH_BOARDS);
+	}
+
+	printf("  %-16s %.2f us/grid, %.1f cache lines/grid, L1D misses/grid %s, LLC misses/grid %s\n", name, solve_time,
+		   lines, l1d, llc);
+
+	return RC_NO_ERROR;
+}
+
+/***********************************************************************************************************************
+ *                                                                                                                     *
+ * FUNCTION: benchLayout                                                                                               *
+ *                                                                                                                     *
+ * DESCRIPTION: compare the base word list character nodes in malloc order with a level order and a profile-guided     *
+ *              node arena                                                                                             *
+ *                                                                                                                     *
+ * PARAMETERS: base_grid - (in/out) words grid of the base word list                                                   *
+ *                                                                                                                     *
+ * RETURN: RC_NO_ERROR - no error                                                                                      *
+ *         RC_BAD_FORMAT - layout file error                                                                           *
+ *         RC_NO_MEM - no memory                                                                                       *
+ *                                                                                                                     *
+ * NOTES: the base word list is left in the profile-guided layout                                                      *
+ *                                                                                                                     *
+ ***********************************************************************************************************************/
+static RETURN_CODE benchLayout (WordsGrid *base_grid)
+{
+	WordList *base = &(base_grid->word_list);
+	WordListProfile profile;
+	unsigned int *layout, *loaded_layout;
+	unsigned long malloc_checksum, checksum;
+	char grid_string[GRID_CELLS+1];
+	FILE *layout_file;
+	clock_t start;
+	int i, c;
+	RETURN_CODE ret_code;
+
+	layout = (unsigned int*)malloc(base->allocated_nodes * sizeof(unsigned int));
+	loaded_layout = (unsigned int*)malloc(base->allocated_nodes * sizeof(unsigned int));
+	if ((layout == NULL) || (loaded_layout == NULL))
+	{
+		free(layout);
+		free(loaded_layout);
+		return RC_NO_MEM;
+	}
+
+	printf("layout: %lu nodes\n", (unsigned long)base->allocated_nodes);
+	ret_code = measureLayout(base_grid, "malloc order:", &malloc_checksum);
+
+	/* profile on other grids than the measured ones */
+	if (ret_code == RC_NO_ERROR)
+	{
+		start = clock();
+		ret_code = WordList_InitProfile(&profile, base);
+		srand(2);
+		for (i = 0; (i < BENCH_SAMPLE) && (ret_code == RC_NO_ERROR); i++)
+		{
+			for (c = 0; c < GRID_CELLS; c++)
+			{
+				grid_string[c] = BENCH_LETTERS[rand() % (sizeof(BENCH_LETTERS)-1)];
+			}
+			grid_string[GRID_CELLS] = '\0';
+
+			WordsGrid_SetGrid(base_grid, grid_string);
+			ret_code = WordsGrid_Solve(base_grid);
+			WordsGrid_ProfileNodes(base_grid, &profile);
+		}
+		if (ret_code == RC_NO_ERROR)
+		{
+			ret_code = WordList_ProfileLayout(&profile, layout);
+		}
+		WordList_FreeProfile(&profile);
+
+		printf("  profiled %d grids in %.1f ms\n", BENCH_SAMPLE, ((double)(clock() - start) / CLOCKS_PER_SEC) * 1e3);
+	}
+
+	/* the layout goes through a layout file */
+	if (ret_code == RC_NO_ERROR)
+	{
+		layout_file = tmpfile();
+		if (layout_file == NULL)
+		{
+			ret_code = RC_FILE_NOT_FOUND;
+		}
+		else
+		{
+			ret_code = WordList_SaveLayout(layout, base->allocated_nodes, layout_file);
+			if (ret_code == RC_NO_ERROR)
+			{
+				rewind(layout_file);
+				ret_code = WordList_LoadLayout(loaded_layout, base->allocated_nodes, layout_file);
+			}
+			if ((ret_code == RC_NO_ERROR) && (memcmp(layout, loaded_layout, base->allocated_nodes * sizeof(unsigned int)) != 0))
+			{
+				ret_code = RC_BAD_FORMAT;
+			}
+			fclose(layout_file);
+		}
+	}
+
+	if (ret_code == RC_NO_ERROR)
+	{
+		ret_code = WordsGrid_Relayout(base_grid, NULL);
+	}
+	if (ret_code == RC_NO_ERROR)
+	{
+		ret_code = measureLayout(base_grid, "level order:", &checksum);
+		if (checksum != malloc_checksum)
+		{
+			printf("  (OUTPUT MISMATCH)\n");
+		}
+	}
+
+	if (ret_code == RC_NO_ERROR)
+	{
+		ret_code = WordsGrid_Relayout(base_grid, loaded_layout);
+	}
+	if (ret_code == RC_NO_ERROR)
+	{
+		ret_code = measureLayout(base_grid, "profile-guided:", &checksum);
+		if (checksum != malloc_checksum)
+		{
+			printf("  (OUTPUT MISMATCH)\n");
+		}
+	}
+
+	free(layout);
+	free(loaded_layout);
+
+	return ret_code;
+}
+
+/***********************************************************************************************************************
+ *                                                                                                                     *
+ * FUNCTION: wallClock                                                                                                 *
+ *                                                                                                                     *
+ * DESCRIPTION: wall clock time (clock() is the CPU time of all threads)                                               *
+ *                                                                                                                     *
+ * PARAMETERS: none                                                                                                    *
+ *                                                                                                                     *
+ * RETURN: time in seconds                                                                                             *
+ *                                                                                                                     *
+ * NOTES:                                                                                                              *
+ *                                                                                                                     *
+ ***********************************************************************************************************************/
+static double wallClock (void)
+{
+	struct timespec now;
+
+	timespec_get(&now, TIME_UTC);
+
+	return (double)now.tv_sec + ((double)now.tv_nsec * 1e-9);
+}
+
+/***********************************************************************************************************************
+ *                                                                                                                     *
+ * FUNCTION: benchParallel                                                                                             *
+ *                                                                                                                     *
+ * DESCRIPTION: compare the solve time of one grid by a serial search and by a parallel search                         *
+ *                                                                                                                     *
+ * PARAMETERS: base_grid - (in/out) words grid of the base word list                                                   *
+ *                                                                                                                     *
+ * RETURN: RC_NO_ERROR - no error                                                                                      *
+ *         RC_NO_MEM - no memory                                                                                       *
+ *                                                                                                                     *
+ * NOTES: the speedup is bound by the number of cores                                                                  *
+ *                                                                                                                     *
+ ***********************************************************************************************************************/
+static RETURN_CODE benchParallel (WordsGrid *base_grid)
+{
+	static const int threads[] = {1, 2, 4, 8};
+	char grid_string[GRID_CELLS+1];
+	unsigned long checksums[sizeof(threads) / sizeof(threads[0])];
+	double times[sizeof(threads) / sizeof(threads[0])] = {0}, start;
+	int i, c, t;
+	RETURN_CODE ret_code = RC_NO_ERROR;
+
+	srand(1);
+	for (i = 0; (i < BENCH_SAMPLE) && (ret_code == RC_NO_ERROR); i++)
+	{
+		for (c = 0; c < GRID_CELLS; c++)
+		{
+			grid_string[c] = BENCH_LETTERS[rand() % (sizeof(BENCH_LETTERS)-1)];
+		}
+		grid_string[GRID_CELLS] = '\0';
+		WordsGrid_SetGrid(base_grid, grid_string);
+
+		/* warm up (the first search of a grid pays its cache misses) */
+		WordsGrid_OutputFoundWords(base_grid);
+
+		for (t = 0; (t < (int)(sizeof(threads) / sizeof(threads[0]))) && (ret_code == RC_NO_ERROR); t++)
+		{
+			found_checksum = (i == 0)? 0: checksums[t];
+			start = wallClock();
+			ret_code = WordsGrid_OutputFoundWordsParallel(base_grid, threads[t]);
+			times[t] += wallClock() - start;
+			checksums[t] = found_checksum;
+		}
+	}
+
+	if (ret_code == RC_NO_ERROR)
+	{
+		printf("parallel: %dx%d grid\n", GRID_X_LEN, GRID_Y_LEN);
+		for (t = 0; t < (int)(sizeof(threads) / sizeof(threads[0])); t++)
+		{
+			printf("  %d thread%s %10.2f us/grid (x%.2f)%s\n", threads[t], (threads[t] == 1)? ": ": "s:", times[t] * 1e6 / BENCH_SAMPLE,
+				   times[0] / times[t], (checksums[t] == checksums[0])? "": " (OUTPUT MISMATCH)");
+		}
+	}
+
+	return ret_code;
+}
+
+/***********************************************************************************************************************
+ *                                                                                                                     *
+ * FUNCTION: benchSetCell                                                                                              *
+ *                                                                                                                     *
+ * DESCRIPTION: compare re-solving a grid after a single cell change incrementally (WordsGrid_SetCell) with a full     *
+ *              re-solve (WordsGrid_SetGrid and WordsGrid_Solve) - a random walk of BENCH_CELL_CHANGES cell changes    *
+ *                                                                                                                     *
+ * PARAMETERS: base_grid - (in/out) words grid of the base word list                                                   *
+ *                                                                                                                     *
+ * RETURN: RC_NO_ERROR - no error                                                                                      *
+ *         RC_NO_MEM - no memory                                                                                       *
+ *                                                                                                                     *
+ * NOTES: the number of words and the score after every change are compared (and the words gained and lost of every    *
+ *        delta with the change in the number of words)                                                                *
+ *                                                                                                                     *
+ ***********************************************************************************************************************/
+static RETURN_CODE benchSetCell (WordsGrid *base_grid)
+{
+	char grid_string[GRID_CELLS+1];
+	int scores[BENCH_CELL_CHANGES];
+	size_t no_of_words[BENCH_CELL_CHANGES], old_no_of_words;
+	WordsGridDelta delta;
+	double set_cell_time = 0, solve_time = 0, run_time;
+	clock_t start;
+	int run, i, k, cell, mismatch = 0;
+	RETURN_CODE ret_code = RC_NO_ERROR;
+
+	for (run = 0; (run < BENCH_RUNS) && (ret_code == RC_NO_ERROR); run++)
+	{
+		/* incremental: the same start grid and cell changes on every run */
+		srand(1);
+		for (k = 0; k < GRID_CELLS; k++)
+		{
+			grid_string[k] = BENCH_LETTERS[rand() % (sizeof(BENCH_LETTERS)-1)];
+		}
+		grid_string[GRID_CELLS] = '\0';
+		WordsGrid_SetGrid(base_grid, grid_string);
+		ret_code = WordsGrid_Solve(base_grid);
+
+		start = clock();
+		for (i = 0; (i < BENCH_CELL_CHANGES) && (ret_code == RC_NO_ERROR); i++)
+		{
+			cell = rand() % GRID_CELLS;
+			grid_string[cell] = BENCH_LETTERS[rand() % (sizeof(BENCH_LETTERS)-1)];
+
+			old_no_of_words = base_grid->result_set.no_of_words;
+			ret_code = WordsGrid_SetCell(base_grid, cell / GRID_Y_LEN, cell % GRID_Y_LEN, grid_string[cell], &delta);
+
+			scores[i] = delta.score;
+			no_of_words[i] = base_grid->result_set.no_of_words;
+			mismatch |= ((old_no_of_words + delta.words_gained - delta.words_lost) != no_of_words[i]) || (delta.score != base_grid->result_set.score);
+		}
+		run_time = ((double)(clock() - start) / CLOCKS_PER_SEC) * 1e6 / BENCH_CELL_CHANGES;
+		set_cell_time = ((run == 0) || (run_time < set_cell_time))? run_time: set_cell_time;
+
+		/* full re-solve of the same grids */
+		srand(1);
+		for (k = 0; k < GRID_CELLS; k++)
+		{
+			grid_string[k] = BENCH_LETTERS[rand() % (sizeof(BENCH_LETTERS)-1)];
+		}
+
+		start = clock();
+		for (i = 0; (i < BENCH_CELL_CHANGES) && (ret_code == RC_NO_ERROR); i++)
+		{
+			cell = rand() % GRID_CELLS;
+			grid_string[cell] = BENCH_LETTERS[rand() % (sizeof(BENCH_LETTERS)-1)];
+
+			WordsGrid_SetGrid(base_grid, grid_string);
+			ret_code = WordsGrid_Solve(base_grid);
+
+			mismatch |= (base_grid->result_set.score != scores[i]) || (base_grid->result_set.no_of_words != no_of_words[i]);
+		}
+		run_time = ((double)(clock() - start) / CLOCKS_PER_SEC) * 1e6 / BENCH_CELL_CHANGES;
+		solve_time = ((run == 0) || (run_time < solve_time))? run_time: solve_time;
+	}
+
+	if (ret_code == RC_NO_ERROR)
+	{
+		printf("setcell: %d single cell changes of a %dx%d grid\n", BENCH_CELL_CHANGES, GRID_X_LEN, GRID_Y_LEN);
+		printf("  SetGrid + Solve: %10.2f us/change\n", solve_time);
+		printf("  SetCell:         %10.2f us/change (x%.2f)%s\n", set_cell_time, solve_time / set_cell_time, mismatch? " (OUTPUT MISMATCH)": "");
+	}
+
+	return ret_code;
+}
+
+/***********************************************************************************************************************
+ *                                                                                                                     *
+ * FUNCTION: batchSolveRules                                                                                           *
+ *                                                                                                                     *
+ * DESCRIPTION: solve BENCH_SAMPLE random grids (same grids on every call) by the words grid game rules                *
+ *                                                                                                                     *
+ * PARAMETERS: words_grid - (in/out) pointer to words grid                                                             *
+ *             solve_game - (in) 1 - WordsGrid_SolveGame, 0 - WordsGrid_Solve                                          *
+ *             no_of_words, score - (out) total number of words found and total score of all grids                     *
+ *             ret_code - (out) RC_NO_ERROR or RC_NO_MEM                                                               *
+ *                                                                                                                     *
+ * RETURN: time per grid in microseconds                                                                               *
+ *                                                                                                                     *
+ * NOTES:                                                                                                              *
+ *                                                                                                                     *
+ ***********************************************************************************************************************/
+static double batchSolveRules (WordsGrid *words_grid, int solve_game, size_t *no_of_words, long *score, RETURN_CODE *ret_code)
+{
+	char grid_string[GRID_CELLS+1];
+	clock_t start;
+	int i, k;
+
+	srand(1);
+	*no_of_words = 0;
+	*score = 0;
+	*ret_code = RC_NO_ERROR;
+	start = clock();
+
+	for (i = 0; (i < BENCH_SAMPLE) && (*ret_code == RC_NO_ERROR); i++)
+	{
+		for (k = 0; k < GRID_CELLS; k++)
+		{
+			grid_string[k] = BENCH_LETTERS[rand() % (sizeof(BENCH_LETTERS)-1)];
+		}
+		grid_string[GRID_CELLS] = '\0';
+		WordsGrid_SetGrid(words_grid, grid_string);
+
+		if (solve_game)
+		{
+			*ret_code = WordsGrid_SolveGame(words_grid);
+			*no_of_words += words_grid->game_result.no_of_words;
+			*score += words_grid->game_result.score;
+		}
+		else
+		{
+			*ret_code = WordsGrid_Solve(words_grid);
+			*no_of_words += words_grid->result_set.no_of_words;
+			*score += words_grid->result_set.score;
+		}
+	}
+
+	return ((double)(clock() - start) / CLOCKS_PER_SEC) * 1e6 / BENCH_SAMPLE;
+}
+
+/***********************************************************************************************************************
+ *                                                                                                                     *
+ * FUNCTION: benchRules                                                                                                *
+ *                                                                                                                     *
+ * DESCRIPTION: compare solving grids by Boggle rules into the result set and into the game result                     *
+ *                                                                                                                     *
+ * PARAMETERS: base_grid - (in/out) words grid of the base word list                                                   *
+ *                                                                                                                     *
+ * RETURN: RC_NO_ERROR - no error                                                                                      *
+ *         RC_NO_MEM - no memory                                                                                       *
+ *                                                                                                                     *
+ * NOTES: the base grid is left with the default rules                                                                 *
+ *                                                                                                                     *
+ ***********************************************************************************************************************/
+static RETURN_CODE benchRules (WordsGrid *base_grid)
+{
+	static const char *names[] = {"result set:", "game, paths:", "game, no paths:", "game, max length 6:"};
+	GameRules rules;
+	size_t no_of_words[4];
+	long scores[4];
+	double times[4] = {0}, time;
+	int run, k;
+	RETURN_CODE ret_code = RC_NO_ERROR;
+
+	for (run = 0; (run < BENCH_RUNS) && (ret_code == RC_NO_ERROR); run++)
+	{
+		for (k = 0; (k < 4) && (ret_code == RC_NO_ERROR); k++)
+		{
+			WordsGrid_BoggleRules(&rules);
+			rules.return_paths = (k != 2);
+			rules.max_len = (k == 3)? 6: rules.max_len;
+			WordsGrid_SetRules(base_grid, &rules);
+
+			time = batchSolveRules(base_grid, (k != 0), &(no_of_words[k]), &(scores[k]), &ret_code);
+			times[k] = ((run == 0) || (time < times[k]))? time: times[k];
+		}
+	}
+
+	WordsGrid_SetRules(base_grid, NULL);
+
+	if (ret_code == RC_NO_ERROR)
+	{
+		printf("rules: Boggle rules, %d grids\n", BENCH_SAMPLE);
+		for (k = 0; k < 4; k++)
+		{
+			printf("  %-20s %10.2f us/grid %8.1f words/grid %8.1f score/grid%s\n", names[k], times[k], (double)no_of_words[k] / BENCH_SAMPLE,
+				   (double)scores[k] / BENCH_SAMPLE, ((k == 3) || ((no_of_words[k] == no_of_words[0]) && (scores[k] == scores[0])))? "": " (OUTPUT MISMATCH)");
+		}
+	}
+
+	return ret_code;
+}
+
+/*******************************************************************************************************************************************************/
+/************************************************************ external functions definition ************************************************************/
+/*******************************************************************************************************************************************************/
+int main (int argc, char* argv[])
+{
+	WordsGrid base_grid, variant_grid;
+	RETURN_CODE ret_code = RC_NO_ERROR;
+	FILE *base_file, *variant_file;
+
+	if (argc != 3)
+	{
+		printf("Usage: bench.exe <base-word-list-file> <variant-word-list-file>\n");
+		return 0;
+	}
+
+	base_file = fopen(argv[1], "r");
+	variant_file = fopen(argv[2], "r");
+	if ((base_file == NULL) || (variant_file == NULL))
+	{
+		ret_code = RC_FILE_NOT_FOUND;
+	}
+	else
+	{
+		ret_code = WordsGrid_InitWordList(&base_grid, base_file);
+		if (ret_code == RC_EOF)
+		{
+			ret_code = WordsGrid_InitWordList(&variant_grid, variant_file);
+			if (ret_code != RC_EOF)
+			{
+				WordsGrid_Free(&variant_grid);
+			}
+		}
+
+		if (ret_code == RC_EOF)
+		{
+			WordsGrid_SetOutputFunc(&base_grid, benchOutputFunc);
+			WordsGrid_SetOutputFunc(&variant_grid, benchOutputFunc);
+
+			ret_code = benchOverlay(&base_grid, &variant_grid);
+			if (ret_code == RC_NO_ERROR)
+			{
+				ret_code = benchOverlayLookup(&base_grid);
+			}
+			if (ret_code == RC_NO_ERROR)
+			{
+				ret_code = benchLouds(&base_grid);
+			}
+			if (ret_code == RC_NO_ERROR)
+			{
+				ret_code = benchPattern(&base_grid);
+			}
+			if (ret_code == RC_NO_ERROR)
+			{
+				ret_code = benchRack(&base_grid);
+			}
+			if (ret_code == RC_NO_ERROR)
+			{
+				ret_code = benchParallel(&base_grid);
+			}
+			if (ret_code == RC_NO_ERROR)
+			{
+				ret_code = benchLayout(&base_grid);
+			}
+			if (ret_code == RC_NO_ERROR)
+			{
+				ret_code = benchSetCell(&base_grid);
+			}
+			if (ret_code == RC_NO_ERROR)
+			{
+				ret_code = benchRules(&base_grid);
+			}
+
+			WordsGrid_Free(&variant_grid);
+		}
+
+		WordsGrid_Free(&base_grid);
+	}
+
+	if (base_file != NULL)
+	{
+		fclose(base_file);
+	}
+	if (variant_file != NULL)
+	{
+		fclose(variant_file);
+	}
+
+	if (ret_code != RC_NO_ERROR)
+	{
+		printf("ERROR: error code #%d\n", ret_code);
+	}
+
+	return 0;
+}
@@ -0,0 +1,457 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+#include "gen_defs.h"
+#include "word_list.h"
+#include "words_grid.h"
+
+#include "grid_cache.h"
+
+/*
+ CONCEPT: a grid and its rotations/reflections have the same found words (the symmetries keep cells adjacency), so
+ result sets are cached once per canonical grid - the lexicographically smallest symmetric form. found word paths
+ are kept in canonical grid cells and mapped back to the grid cells by the inverse symmetry.
+
+ e.g. (2 x 2) "dcba" (d c / b a) is cached as its 180 degrees rotation "abcd" (a b / c d)
+ */
+
+/*******************************************************************************************************************************************************/
+/************************************************************ internal functions declation *************************************************************/
+/*******************************************************************************************************************************************************/
+static size_t gridHash (const char *canonical_grid);
+static GridCacheEntry* findEntry (GridCache *grid_cache, const char *canonical_grid, size_t hash);
+static void lruUnlink (GridCache *grid_cache, GridCacheEntry *entry);
+static void lruPushFront (GridCache *grid_cache, GridCacheEntry *entry);
+static void evictEntry (GridCache *grid_cache, GridCacheEntry *entry);
+
+/*******************************************************************************************************************************************************/
+/************************************************************ internal functions definition ************************************************************/
+/*******************************************************************************************************************************************************/
+/***********************************************************************************************************************
+ *                                                                                                                     *
+ * FUNCTION: gridHash                                                                                                  *
+ *                                                                                                                     *
+ * DESCRIPTION: hash of a canonical grid (FNV-1a)                                                                      *
+ *                                                                                                                     *
+ * PARAMETERS: canonical_grid - (in) canonical grid                                                                    *
+ *                                                                                                                     *
+ * RETURN: hash value                                                                                                  *
+ *                                                                                                                     *
+ * NOTES:                                                                                                              *
+ *                                                                                                                     *
+ ***********************************************************************************************************************/
+static size_t gridHash (const char *canonical_grid)
+{
+	size_t hash = 2166136261u;
+	int k;
+
+	for (k = 0; k < GRID_CELLS; k++)
+	{
+		hash ^= (unsigned char)canonical_grid[k];
+		hash *= 16777619u;
+	}
+
+	return hash;
+}
+
+/***********************************************************************************************************************
+ *                                                                                                                     *
+ * FUNCTION: findEntry                                                                                                 *
+ *                                                                                                                     *
+ * DESCRIPTION: find the cache entry of a canonical grid                                                               *
+ *                                                                                                                     *
+ * PARAMETERS: grid_cache - (in) pointer to grid cache                                                                 *
+ *             canonical_grid - (in) canonical grid                                                                    *
+ *             hash - (in) hash of canonical grid                                                                      *
+ *                                                                                                                     *
+ * RETURN: pointer to cache entry (or NULL if the grid is not cached)                                                  *
+ *                                                                                                                     *
+ * NOTES:                                                                                                              *
+ *                                                                                                                     *
+ ***********************************************************************************************************************/
+static GridCacheEntry* findEntry (GridCache *grid_cache, const char *canonical_grid, size_t hash)
+{
+	GridCacheEntry *entry;
+
+	for (entry = grid_cache->buckets[hash & (grid_cache->no_of_buckets - 1)]; entry != NULL; entry = entry->hash_next)
+	{
+		if ((entry->hash == hash) && (memcmp(entry->grid, canonical_grid, GRID_CELLS) == 0))
+		{
+			break;
+		}
+	}
+
+	return entry;
+}
+
+/***********************************************************************************************************************
+ *                                                                                                                     *
+ * FUNCTION: lruUnlink                                                                                                 *
+ *                                                                                                                     *
+ * DESCRIPTION: remove an entry from the LRU list                                                                      *
+ *                                                                                                                     *
+ * PARAMETERS: grid_cache - (in/out) pointer to grid cache                                                             *
+ *             entry - (in/out) pointer to cache entry                                                                 *
+ *                                                                                                                     *
+ * RETURN: none                                                                                                        *
+ *                                                                                                                     *
+ * NOTES:                                                                                                              *
+ *                                                                                                                     *
+ ***********************************************************************************************************************/
+static void lruUnlink (GridCache *grid_cache, GridCacheEntry *entry)
+{
+	if (entry->lru_prev != NULL)
+	{
+		entry->lru_prev->lru_next = entry->lru_next;
+	}
+	else
+	{
+		grid_cache->lru_head = entry->lru_next;
+	}
+
+	if (entry->lru_next != NULL)
+	{
+		entry->lru_next->lru_prev = entry->lru_prev;
+	}
+	else
+	{
+		grid_cache->lru_tail = entry->lru_prev;
+	}
+
+	entry->lru_prev = NULL;
+	entry->lru_next = NULL;
+}
+
+/***********************************************************************************************************************
+ *                                                                                                                     *
+ * FUNCTION: lruPushFront                                                                                              *
+ *                                                                                                                     *
+ * DESCRIPTION: add an entry to the LRU list as the most recently used                                                 *
+ *                                                                                                                     *
+ * PARAMETERS: grid_cache - (in/out) pointer to grid cache                                                             *
+ *             entry - (in/out) pointer to cache entry (not in LRU list)                                               *
+ *                                                                                                                     *
+ * RETURN: none                                                                                                        *
+ *                                                                                                                     *
+ * NOTES:                                                                                                              *
+ *                                                                                                                     *
+ ***********************************************************************************************************************/
+static void lruPushFront (GridCache *grid_cache, GridCacheEntry *entry)
+{
+	entry->lru_prev = NULL;
+	entry->lru_next = grid_cache->lru_head;
+
+	if (grid_cache->lru_head != NULL)
+	{
+		grid_cache->lru_head->lru_prev = entry;
+	}
+	else
+	{
+		grid_cache->lru_tail = entry;
+	}
+	grid_cache->lru_head = entry;
+}
+
+/***********************************************************************************************************************
+ *                                                                                                                     *
+ * FUNCTION: evictEntry                                                                                                *
+ *                                                                                                                     *
+ * DESCRIPTION: remove an entry from grid cache and free it                                                            *
+ *                                                                                                                     *
+ * PARAMETERS: grid_cache - (in/out) pointer to grid cache                                                             *
+ *             entry - (in/out) pointer to cache entry                                                                 *
+ *                                                                                                                     *
+ * RETURN: none                                                                                                        *
+ *                                                                                                                     *
+ * NOTES:                                                                                                              *
+ *                                                                                                                     *
+ ***********************************************************************************************************************/
+static void evictEntry (GridCache *grid_cache, GridCacheEntry *entry)
+{
+	GridCacheEntry **bucket;
+
+	for (bucket = &(grid_cache->buckets[entry->hash & (grid_cache->no_of_buckets - 1)]); (*bucket) != entry; bucket = &((*bucket)->hash_next))
+	{
+		assert(*bucket);
+	}
+	(*bucket) = entry->hash_next;
+
+	lruUnlink(grid_cache, entry);
+	grid_cache->no_of_entries--;
+
+	/* entry and its result set are one allocation */
+	free(entry);
+}
+
+/*******************************************************************************************************************************************************/
+/************************************************************ external functions definition ************************************************************/
+/*******************************************************************************************************************************************************/
+RETURN_CODE GridCache_Init (GridCache *grid_cache, size_t capacity)
+{
+	memset(grid_cache, 0, sizeof(GridCache));
+
+	assert(capacity);
+	grid_cache->capacity = capacity;
+
+	for (grid_cache->no_of_buckets = 1; grid_cache->no_of_buckets < capacity; grid_cache->no_of_buckets *= 2);
+
+	grid_cache->buckets = (GridCacheEntry**)calloc(grid_cache->no_of_buckets, sizeof(GridCacheEntry*));
+	if (grid_cache->buckets == NULL)
+	{
+		return RC_NO_MEM;
+	}
+
+	return RC_NO_ERROR;
+}
+
+int GridCache_CanonicalGrid (char grid[][GRID_Y_LEN], char *canonical_grid)
+{
+	char symmetric_grid[GRID_CELLS];
+	int symmetry, canonical_symmetry = 0;
+	int i, j;
+
+	for (symmetry = 0; symmetry < GRID_SYMMETRIES; symmetry++)
+	{
+		for (i = 0; i < GRID_X_LEN; i++)
+		{
+			for (j = 0; j < GRID_Y_LEN; j++)
+			{
+				symmetric_grid[GridCache_MapCell(symmetry, (CellIndex)((i * GRID_Y_LEN) + j))] = grid[i][j];
+			}
+		}
+
+		if ((symmetry == 0) || (memcmp(symmetric_grid, canonical_grid, GRID_CELLS) < 0))
+		{
+			memcpy(canonical_grid, symmetric_grid, GRID_CELLS);
+			canonical_symmetry = symmetry;
+		}
+	}
+
+	return canonical_symmetry;
+}
+
+CellIndex GridCache_MapCell (int symmetry, CellIndex cell)
+{
+	int x = cell / GRID_Y_LEN;
+	int y = cell % GRID_Y_LEN;
+	int sx, sy;
+
+	switch (symmetry)
+	{
+	case 0: /* identity */
+		sx = x;
+		sy = y;
+		break;
+	case 1: /* 180 degrees rotation */
+		sx = (GRID_X_LEN - 1) - x;
+		sy = (GRID_Y_LEN - 1) - y;
+		break;
+	case 2: /* top-bottom reflection */
+		sx = (GRID_X_LEN - 1) - x;
+		sy = y;
+		break;
+	case 3: /* left-right reflection */
+		sx = x;
+		sy = (GRID_Y_LEN - 1) - y;
+		break;
+#if (GRID_SYMMETRIES == 8)
+	case 4: /* 90 degrees rotation */
+		sx = y;
+		sy = (GRID_X_LEN - 1) - x;
+		break;
+	case 5: /* 270 degrees rotation */
+		sx = (GRID_Y_LEN - 1) - y;
+		sy = x;
+		break;
+	case 6: /* main diagonal reflection */
+		sx = y;
+		sy = x;
+		break;
+	case 7: /* anti-diagonal reflection */
+		sx = (GRID_Y_LEN - 1) - y;
+		sy = (GRID_X_LEN - 1) - x;
+		break;
+#endif
+	default:
+		assert(0);
+		sx = x;
+		sy = y;
+		break;
+	}
+
+	return (CellIndex)((sx * GRID_Y_LEN) + sy);
+}
+
+GridCacheEntry* GridCache_Find (GridCache *grid_cache, const char *canonical_grid, int with_paths)
+{
+	GridCacheEntry *entry;
+
+	entry = findEntry(grid_cache, canonical_grid, gridHash(canonical_grid));
+	if ((entry == NULL) || (with_paths && (entry->cells == NULL)))
+	{
+		grid_cache->misses++;
+		return NULL;
+	}
+
+	lruUnlink(grid_cache, entry);
+	lruPushFront(grid_cache, entry);
+
+	grid_cache->hits++;
+	return entry;
+}
+
+void GridCache_InitBuilder (GridCacheBuilder *builder, int with_paths)
+{
+	memset(builder, 0, sizeof(GridCacheBuilder));
+	builder->with_paths = with_paths;
+	builder->ret_code = RC_NO_ERROR;
+}
+
+void GridCache_AddPath (GridCacheBuilder *builder, unsigned int word_id, CellIndex *path, int path_len)
+{
+	size_t allocated;
+	void *ptr;
+
+	if (builder->ret_code != RC_NO_ERROR)
+	{
+		return;
+	}
+
+	if (builder->no_of_paths == builder->allocated_paths)
+	{
+		allocated = (builder->allocated_paths == 0)? 256: (2 * builder->allocated_paths);
+
+		ptr = realloc(builder->word_ids, allocated * sizeof(unsigned int));
+		if (ptr == NULL)
+		{
+			builder->ret_code = RC_NO_MEM;
+			return;
+		}
+		builder->word_ids = (unsigned int*)ptr;
+
+		if (builder->with_paths)
+		{
+			ptr = realloc(builder->path_lens, allocated * sizeof(unsigned char));
+			if (ptr == NULL)
+			{
+				builder->ret_code = RC_NO_MEM;
+				return;
+			}
+			builder->path_lens = (unsigned char*)ptr;
+		}
+
+		builder->allocated_paths = allocated;
+	}
+
+	builder->word_ids[builder->no_of_paths] = word_id;
+
+	if (builder->with_paths)
+	{
+		if ((builder->no_of_cells + path_len) > builder->allocated_cells)
+		{
+			for (allocated = ((builder->allocated_cells == 0)? 1024: builder->allocated_cells); allocated < (builder->no_of_cells + path_len); allocated *= 2);
+
+			ptr = realloc(builder->cells, allocated * sizeof(CellIndex));
+			if (ptr == NULL)
+			{
+				builder->ret_code = RC_NO_MEM;
+				return;
+			}
+			builder->cells = (CellIndex*)ptr;
+			builder->allocated_cells = allocated;
+		}
+
+		builder->path_lens[builder->no_of_paths] = (unsigned char)path_len;
+		memcpy(&(builder->cells[builder->no_of_cells]), path, path_len * sizeof(CellIndex));
+		builder->no_of_cells += path_len;
+	}
+
+	builder->no_of_paths++;
+}
+
+RETURN_CODE GridCache_AddEntry (GridCache *grid_cache, GridCacheBuilder *builder, const char *canonical_grid, int symmetry)
+{
+	GridCacheEntry *entry;
+	GridCacheEntry **bucket;
+	size_t no_of_paths = builder->no_of_paths;
+	size_t no_of_cells = builder->no_of_cells;
+	size_t hash;
+
+	if (builder->ret_code != RC_NO_ERROR)
+	{
+		return builder->ret_code;
+	}
+
+	/* an entry of word IDs only is replaced by an entry with paths */
+	hash = gridHash(canonical_grid);
+	entry = findEntry(grid_cache, canonical_grid, hash);
+	if (entry != NULL)
+	{
+		evictEntry(grid_cache, entry);
+	}
+	else if (grid_cache->no_of_entries == grid_cache->capacity)
+	{
+		evictEntry(grid_cache, grid_cache->lru_tail);
+		grid_cache->evictions++;
+	}
+
+	/* one allocation: entry, word IDs, cells and path lengths (in decreasing alignment order) */
+	entry = (GridCacheEntry*)malloc(sizeof(GridCacheEntry) + (no_of_paths * sizeof(unsigned int)) +
+									(builder->with_paths? ((no_of_cells * sizeof(CellIndex)) + no_of_paths): 0));
+	if (entry == NULL)
+	{
+		return RC_NO_MEM;
+	}
+
+	memcpy(entry->grid, canonical_grid, GRID_CELLS);
+	entry->hash = hash;
+	entry->symmetry = symmetry;
+	entry->no_of_paths = no_of_paths;
+	entry->word_ids = (unsigned int*)(entry + 1);
+	entry->cells = builder->with_paths? (CellIndex*)(entry->word_ids + no_of_paths): NULL;
+	entry->path_lens = builder->with_paths? (unsigned char*)(entry->cells + no_of_cells): NULL;
+
+	/* a grid with no words has nothing allocated to copy from */
+	if (no_of_paths != 0)
+	{
+		memcpy(entry->word_ids, builder->word_ids, no_of_paths * sizeof(unsigned int));
+		if (builder->with_paths)
+		{
+			memcpy(entry->cells, builder->cells, no_of_cells * sizeof(CellIndex));
+			memcpy(entry->path_lens, builder->path_lens, no_of_paths);
+		}
+	}
+
+	bucket = &(grid_cache->buckets[hash & (grid_cache->no_of_buckets - 1)]);
+	entry->hash_next = (*bucket);
+	(*bucket) = entry;
+
+	lruPushFront(grid_cache, entry);
+	grid_cache->no_of_entries++;
+
+	return RC_NO_ERROR;
+}
+
+void GridCache_FreeBuilder (GridCacheBuilder *builder)
+{
+	free(builder->word_ids);
+	free(builder->cells);
+	free(builder->path_lens);
+
+	builder->word_ids = NULL;
+	builder->cells = NULL;
+	builder->path_lens = NULL;
+}
+
+void GridCache_Free (GridCache *grid_cache)
+{
+	while (grid_cache->lru_head != NULL)
+	{
+		evictEntry(grid_cache, grid_cache->lru_head);
+	}
+
+	free(grid_cache->buckets);
+	grid_cache->buckets = NULL;
+}
@@ -0,0 +1,232 @@
+#ifndef _GRID_CACHE_H_
+#define _GRID_CACHE_H_
+
+#include <stdio.h>
+#include "word_list.h"
+#include "words_grid.h"
+
+/* number of grid symmetries (rotations and reflections) - a non square grid has no 90 degrees rotations */
+#if (GRID_X_LEN == GRID_Y_LEN)
+#define GRID_SYMMETRIES		8
+#else
+#define GRID_SYMMETRIES		4
+#endif
+
+/* grid cache entry - compact result set of one canonical grid */
+typedef struct _GridCacheEntry
+{
+	/* canonical grid (key) */
+	char grid[GRID_CELLS];
+	size_t hash;
+
+	/* hash bucket chain */
+	struct _GridCacheEntry *hash_next;
+
+	/* LRU list (most recently used first) */
+	struct _GridCacheEntry *lru_prev;
+	struct _GridCacheEntry *lru_next;
+
+	/* found word paths in canonical grid cells: path k is path_lens[k] cells in cells (one after the other) - in the
+	   search order of the grid of symmetry (the grid that was solved); cells and path_lens are NULL if only the word
+	   IDs are kept */
+	int symmetry;
+	size_t no_of_paths;
+	unsigned int *word_ids;
+	CellIndex *cells;
+	unsigned char *path_lens;
+
+} GridCacheEntry;
+
+/* grid cache struct - bounded LRU cache of result sets keyed by canonical grid */
+typedef struct _GridCache
+{
+	/* hash table (size is a power of 2) */
+	GridCacheEntry **buckets;
+	size_t no_of_buckets;
+
+	/* LRU list */
+	GridCacheEntry *lru_head;
+	GridCacheEntry *lru_tail;
+
+	size_t no_of_entries;
+	size_t capacity;
+
+	/* counters (to size the cache) */
+	size_t hits;
+	size_t misses;
+	size_t evictions;
+
+} GridCache;
+
+/* grid cache entry builder - the found word paths of one grid search (GridCache_AddPath), owned by the searching
+   thread (a grid cache may be shared by words grids) */
+typedef struct _GridCacheBuilder
+{
+	/* keep the paths of found words (or only their word IDs) */
+	int with_paths;
+
+	unsigned int *word_ids;
+	CellIndex *cells;
+	unsigned char *path_lens;
+	size_t no_of_paths;
+	size_t no_of_cells;
+	size_t allocated_paths;
+	size_t allocated_cells;
+
+	RETURN_CODE ret_code;
+
+} GridCacheBuilder;
+
+/***********************************************************************************************************************
+ *                                                                                                                     *
+ * FUNCTION: GridCache_Init                                                                                            *
+ *                                                                                                                     *
+ * DESCRIPTION: initialise an empty grid cache                                                                         *
+ *                                                                                                                     *
+ * PARAMETERS: grid_cache - (out) pointer to grid cache                                                                *
+ *             capacity - (in) maximal number of cached grids (least recently used grid is evicted)                    *
+ *                                                                                                                     *
+ * RETURN: RC_NO_ERROR - no error                                                                                      *
+ *         RC_NO_MEM - no memory                                                                                       *
+ *                                                                                                                     *
+ * NOTES: a grid cache holds results of one word list only                                                             *
+ *                                                                                                                     *
+ ***********************************************************************************************************************/
+RETURN_CODE GridCache_Init (GridCache *grid_cache, size_t capacity);
+
+/***********************************************************************************************************************
+ *                                                                                                                     *
+ * FUNCTION: GridCache_CanonicalGrid                                                                                   *
+ *                                                                                                                     *
+ * DESCRIPTION: find the canonical form of a grid - the lexicographically smallest of its symmetric forms              *
+ *              (rotations and reflections, which keep the grid cells adjacency and so the found words)                *
+ *                                                                                                                     *
+ * PARAMETERS: grid - (in) characters grid                                                                             *
+ *             canonical_grid - (out) canonical grid (GRID_CELLS characters, cell index order)                         *
+ *                                                                                                                     *
+ * RETURN: symmetry that maps grid to canonical_grid (0 .. GRID_SYMMETRIES-1)                                          *
+ *                                                                                                                     *
+ * NOTES:                                                                                                              *
+ *                                                                                                                     *
+ ***********************************************************************************************************************/
+int GridCache_CanonicalGrid (char grid[][GRID_Y_LEN], char *canonical_grid);
+
+/***********************************************************************************************************************
+ *                                                                                                                     *
+ * FUNCTION: GridCache_MapCell                                                                                         *
+ *                                                                                                                     *
+ * DESCRIPTION: map a grid cell to its cell in the symmetric form of the grid                                          *
+ *                                                                                                                     *
+ * PARAMETERS: symmetry - (in) symmetry (0 .. GRID_SYMMETRIES-1)                                                       *
+ *             cell - (in) grid cell index                                                                             *
+ *                                                                                                                     *
+ * RETURN: cell index in the symmetric grid                                                                            *
+ *                                                                                                                     *
+ * NOTES:                                                                                                              *
+ *                                                                                                                     *
+ ***********************************************************************************************************************/
+CellIndex GridCache_MapCell (int symmetry, CellIndex cell);
+
+/***********************************************************************************************************************
+ *                                                                                                                     *
+ * FUNCTION: GridCache_Find                                                                                            *
+ *                                                                                                                     *
+ * DESCRIPTION: find the cached result set of a canonical grid (and make it the most recently used)                    *
+ *                                                                                                                     *
+ * PARAMETERS: grid_cache - (in/out) pointer to grid cache                                                             *
+ *             canonical_grid - (in) canonical grid                                                                    *
+ *             with_paths - (in) the paths of the found words are needed (an entry of word IDs only is not found)      *
+ *                                                                                                                     *
+ * RETURN: pointer to cache entry (or NULL if the grid is not cached)                                                  *
+ *                                                                                                                     *
+ * NOTES: counts a hit or a miss                                                                                       *
+ *                                                                                                                     *
+ ***********************************************************************************************************************/
+GridCacheEntry* GridCache_Find (GridCache *grid_cache, const char *canonical_grid, int with_paths);
+
+/***********************************************************************************************************************
+ *                                                                                                                     *
+ * FUNCTION: GridCache_InitBuilder                                                                                     *
+ *                                                                                                                     *
+ * DESCRIPTION: initialise an empty grid cache entry builder                                                           *
+ *                                                                                                                     *
+ * PARAMETERS: builder - (out) pointer to grid cache entry builder                                                     *
+ *             with_paths - (in) keep the paths of found words (or only their word IDs)                                *
+ *                                                                                                                     *
+ * RETURN: none                                                                                                        *
+ *                                                                                                                     *
+ * NOTES: nothing is allocated until the first GridCache_AddPath                                                       *
+ *                                                                                                                     *
+ ***********************************************************************************************************************/
+void GridCache_InitBuilder (GridCacheBuilder *builder, int with_paths);
+
+/***********************************************************************************************************************
+ *                                                                                                                     *
+ * FUNCTION: GridCache_AddPath                                                                                         *
+ *                                                                                                                     *
+ * DESCRIPTION: add a found word path to the cache entry being built                                                   *
+ *                                                                                                                     *
+ * PARAMETERS: builder - (in/out) pointer to grid cache entry builder                                                  *
+ *             word_id - (in) word ID of the found word                                                                *
+ *             path, path_len - (in) grid cells of the found word (in canonical grid cells)                            *
+ *                                                                                                                     *
+ * RETURN: none                                                                                                        *
+ *                                                                                                                     *
+ * NOTES: the entry is added to the cache by GridCache_AddEntry (or dropped if no memory); path is not kept by a       *
+ *        builder of word IDs only                                                                                     *
+ *                                                                                                                     *
+ ***********************************************************************************************************************/
+void GridCache_AddPath (GridCacheBuilder *builder, unsigned int word_id, CellIndex *path, int path_len);
+
+/***********************************************************************************************************************
+ *                                                                                                                     *
+ * FUNCTION: GridCache_AddEntry                                                                                        *
+ *                                                                                                                     *
+ * DESCRIPTION: add the entry being built (all paths added to builder) as the result set of a canonical grid           *
+ *              (the least recently used entry is evicted if the cache is full)                                        *
+ *                                                                                                                     *
+ * PARAMETERS: grid_cache - (in/out) pointer to grid cache                                                             *
+ *             builder - (in) pointer to grid cache entry builder                                                      *
+ *             canonical_grid - (in) canonical grid (a cached entry of it is replaced)                                 *
+ *             symmetry - (in) symmetry that maps the solved grid to canonical grid (the paths are in its search       *
+ *                        order)                                                                                       *
+ *                                                                                                                     *
+ * RETURN: RC_NO_ERROR - no error                                                                                      *
+ *         RC_NO_MEM - no memory (the grid is not cached)                                                              *
+ *                                                                                                                     *
+ * NOTES: builder is not changed (it is freed by GridCache_FreeBuilder)                                                *
+ *                                                                                                                     *
+ ***********************************************************************************************************************/
+RETURN_CODE GridCache_AddEntry (GridCache *grid_cache, GridCacheBuilder *builder, const char *canonical_grid, int symmetry);
+
+/***********************************************************************************************************************
+ *                                                                                                                     *
+ * FUNCTION: GridCache_FreeBuilder                                                                                     *
+ *                                                                                                                     *
+ * DESCRIPTION: free memory dynamically allocated for grid cache entry builder                                         *
+ *                                                                                                                     *
+ * PARAMETERS: builder - (in/out) pointer to grid cache entry builder                                                  *
+ *                                                                                                                     *
+ * RETURN: none                                                                                                        *
+ *                                                                                                                     *
+ * NOTES:                                                                                                              *
+ *                                                                                                                     *
+ ***********************************************************************************************************************/
+void GridCache_FreeBuilder (GridCacheBuilder *builder);
+
+/***********************************************************************************************************************
+ *                                                                                                                     *
+ * FUNCTION: GridCache_Free                                                                                            *
+ *                                                                                                                     *
+ * DESCRIPTION: free memory dynamically allocated for grid cache                                                       *
+ *                                                                                                                     *
+ * PARAMETERS: grid_cache - (in/out) pointer to grid cache                                                             *
+ *                                                                                                                     *
+ * RETURN: none                                                                                                        *
+ *                                                                                                                     *
+ * NOTES: must be called to free grid cache memory at the end of grid cache life time                                  *
+ *                                                                                                                     *
+ ***********************************************************************************************************************/
+void GridCache_Free (GridCache *grid_cache);
+
+#endif // _GRID_CACHE_H_
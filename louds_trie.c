@@ -0,0 +1,369 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+#include "gen_defs.h"
+#include "word_list.h"
+
+#include "louds_trie.h"
+
+/*
+ CONCEPT: LOUDS (level-order unary degree sequence) trie
+
+ nodes are numbered in level order (0 is the root). for each node (in level order) the LOUDS bits hold a 1 bit per
+ child and a 0 bit, so the children of node v start right after the v-th 0 bit (at 0 for the root): if the children
+ of v start at LOUDS position p, their node indices are p-v+1, p-v+2, ... (p 1 bits before, v of them are 0 bits)
+ and so their labels are consecutive.
+
+ e.g. words: a, ab, ac, b (. means IS_WORD is true)
+
+ Root-> a.-> b.
+ |       |
+ |       c.
+ |
+ b.
+
+ node:      0     1(a)   2(b)   3(ab)  4(ac)
+ LOUDS:     110   110    0      0      0
+ labels:          a      b      b      c
+ terminals: 0     1      1      1      1
+ */
+
+#define BITS_PER_WORD	64
+
+/*******************************************************************************************************************************************************/
+/************************************************************ internal functions declation *************************************************************/
+/*******************************************************************************************************************************************************/
+static int popCount (unsigned long long bits);
+static int lowestBit (unsigned long long bits);
+static size_t countNodes (CharNode *char_tree);
+static size_t selectZero (LoudsTrie *louds_trie, size_t k);
+static size_t nextZero (LoudsTrie *louds_trie, size_t pos);
+
+/*******************************************************************************************************************************************************/
+/************************************************************ internal functions definition ************************************************************/
+/*******************************************************************************************************************************************************/
+
+/***********************************************************************************************************************
+ *                                                                                                                     *
+ * FUNCTION: popCount                                                                                                  *
+ *                                                                                                                     *
+ * DESCRIPTION: number of 1 bits                                                                                       *
+ *                                                                                                                     *
+ * PARAMETERS: bits - (in) 64 bits                                                                                     *
+ *                                                                                                                     *
+ * RETURN: number of 1 bits                                                                                            *
+ *                                                                                                                     *
+ * NOTES:                                                                                                              *
+ *                                                                                                                     *
+ ***********************************************************************************************************************/
+static int popCount (unsigned long long bits)
+{
+#ifdef __GNUC__
+	return __builtin_popcountll(bits);
+#else
+	int count;
+
+	for (count = 0; bits != 0; count++)
+	{
+		bits &= bits - 1;
+	}
+
+	return count;
+#endif
+}
+
+/***********************************************************************************************************************
+ *                                                                                                                     *
+ * FUNCTION: lowestBit                                                                                                 *
+ *                                                                                                                     *
+ * DESCRIPTION: index of the lowest 1 bit                                                                              *
+ *                                                                                                                     *
+ * PARAMETERS: bits - (in) 64 bits (not 0)                                                                             *
+ *                                                                                                                     *
+ * RETURN: bit index (0 .. 63)                                                                                         *
+ *                                                                                                                     *
+ * NOTES:                                                                                                              *
+ *                                                                                                                     *
+ ***********************************************************************************************************************/
+static int lowestBit (unsigned long long bits)
+{
+	assert(bits != 0);
+
+#ifdef __GNUC__
+	return __builtin_ctzll(bits);
+#else
+	{
+		int index;
+
+		for (index = 0; !(bits & 1); index++)
+		{
+			bits >>= 1;
+		}
+
+		return index;
+	}
+#endif
+}
+
+/***********************************************************************************************************************
+ *                                                                                                                     *
+ * FUNCTION: countNodes                                                                                                *
+ *                                                                                                                     *
+ * DESCRIPTION: number of character nodes of a character tree                                                          *
+ *                                                                                                                     *
+ * PARAMETERS: char_tree - (in) character tree (sibling list)                                                          *
+ *                                                                                                                     *
+ * RETURN: number of character nodes                                                                                   *
+ *                                                                                                                     *
+ * NOTES:                                                                                                              *
+ *                                                                                                                     *
+ ***********************************************************************************************************************/
+static size_t countNodes (CharNode *char_tree)
+{
+	size_t no_of_nodes = 0;
+
+	for (; char_tree != NULL; char_tree = char_tree->adjacent)
+	{
+		no_of_nodes += 1 + countNodes(char_tree->next);
+	}
+
+	return no_of_nodes;
+}
+
+/***********************************************************************************************************************
+ *                                                                                                                     *
+ * FUNCTION: selectZero                                                                                                *
+ *                                                                                                                     *
+ * DESCRIPTION: position of the k-th (0 based) LOUDS 0 bit                                                             *
+ *                                                                                                                     *
+ * PARAMETERS: louds_trie - (in) pointer to LOUDS trie                                                                 *
+ *             k - (in) 0 bit number                                                                                   *
+ *                                                                                                                     *
+ * RETURN: LOUDS position                                                                                              *
+ *                                                                                                                     *
+ * NOTES: scans from the nearest select sample (at most LOUDS_SELECT_SAMPLE-1 0 bits)                                  *
+ *                                                                                                                     *
+ ***********************************************************************************************************************/
+static size_t selectZero (LoudsTrie *louds_trie, size_t k)
+{
+	unsigned long long zeros;
+	size_t pos, word;
+	size_t remaining;
+	int count;
+
+	pos = louds_trie->select_samples[k / LOUDS_SELECT_SAMPLE];
+	remaining = k % LOUDS_SELECT_SAMPLE;
+	if (remaining == 0)
+	{
+		return pos;
+	}
+
+	/* 0 bits after the sampled one */
+	pos++;
+	word = pos / BITS_PER_WORD;
+	zeros = (~louds_trie->louds[word]) & (~0ULL << (pos % BITS_PER_WORD));
+
+	while ((count = popCount(zeros)) < (int)remaining)
+	{
+		remaining -= count;
+		zeros = ~louds_trie->louds[++word];
+	}
+
+	for (; remaining > 1; remaining--)
+	{
+		zeros &= zeros - 1;
+	}
+
+	return (word * BITS_PER_WORD) + lowestBit(zeros);
+}
+
+/***********************************************************************************************************************
+ *                                                                                                                     *
+ * FUNCTION: nextZero                                                                                                  *
+ *                                                                                                                     *
+ * DESCRIPTION: position of the first LOUDS 0 bit at or after a position                                               *
+ *                                                                                                                     *
+ * PARAMETERS: louds_trie - (in) pointer to LOUDS trie                                                                 *
+ *             pos - (in) LOUDS position                                                                               *
+ *                                                                                                                     *
+ * RETURN: LOUDS position                                                                                              *
+ *                                                                                                                     *
+ * NOTES:                                                                                                              *
+ *                                                                                                                     *
+ ***********************************************************************************************************************/
+static size_t nextZero (LoudsTrie *louds_trie, size_t pos)
+{
+	unsigned long long zeros;
+	size_t word;
+
+	word = pos / BITS_PER_WORD;
+	zeros = (~louds_trie->louds[word]) & (~0ULL << (pos % BITS_PER_WORD));
+
+	while (zeros == 0)
+	{
+		zeros = ~louds_trie->louds[++word];
+	}
+
+	return (word * BITS_PER_WORD) + lowestBit(zeros);
+}
+
+/*******************************************************************************************************************************************************/
+/************************************************************ external functions definition ************************************************************/
+/*******************************************************************************************************************************************************/
+RETURN_CODE LoudsTrie_Build (LoudsTrie *louds_trie, WordList *word_list)
+{
+	CharNode **queue;
+	CharNode *char_node;
+	size_t node, no_of_nodes, pos, zeros, words, k;
+
+	memset(louds_trie, 0, sizeof(LoudsTrie));
+
+	/* nodes: root + character nodes, LOUDS bits: a 1 bit per character node and a 0 bit per node */
+	no_of_nodes = 1 + countNodes(word_list->char_tree);
+	louds_trie->no_of_nodes = no_of_nodes;
+	louds_trie->louds_bits = (2 * no_of_nodes) - 1;
+	louds_trie->no_of_select_samples = ((no_of_nodes - 1) / LOUDS_SELECT_SAMPLE) + 1;
+	words = (no_of_nodes + BITS_PER_WORD - 1) / BITS_PER_WORD;
+
+	/* queue[v] is the character node of node v (v > 0) in level order */
+	queue = (CharNode**)malloc(no_of_nodes * sizeof(CharNode*));
+	louds_trie->louds = (unsigned long long*)calloc((louds_trie->louds_bits / BITS_PER_WORD) + 1, sizeof(unsigned long long));
+	louds_trie->select_samples = (unsigned int*)malloc(louds_trie->no_of_select_samples * sizeof(unsigned int));
+	louds_trie->labels = (char*)malloc(no_of_nodes);
+	louds_trie->terminals = (unsigned long long*)calloc(words, sizeof(unsigned long long));
+	louds_trie->terminal_ranks = (unsigned int*)malloc(words * sizeof(unsigned int));
+
+	if ((queue == NULL) || (louds_trie->louds == NULL) || (louds_trie->select_samples == NULL) || (louds_trie->labels == NULL) ||
+		(louds_trie->terminals == NULL) || (louds_trie->terminal_ranks == NULL))
+	{
+		free(queue);
+		LoudsTrie_Free(louds_trie);
+		return RC_NO_MEM;
+	}
+
+	/* level order walk: children of node v are appended to the queue (and to the LOUDS bits) when v is visited */
+	pos = 0;
+	zeros = 0;
+	k = 1;
+	for (node = 0; node < no_of_nodes; node++)
+	{
+		char_node = (node == 0)? word_list->char_tree: queue[node]->next;
+
+		for (; char_node != NULL; char_node = char_node->adjacent)
+		{
+			queue[k] = char_node;
+			louds_trie->labels[k-1] = char_node->ch;
+			if (char_node->is_word)
+			{
+				louds_trie->terminals[k / BITS_PER_WORD] |= 1ULL << (k % BITS_PER_WORD);
+			}
+			k++;
+
+			louds_trie->louds[pos / BITS_PER_WORD] |= 1ULL << (pos % BITS_PER_WORD);
+			pos++;
+		}
+
+		if ((zeros % LOUDS_SELECT_SAMPLE) == 0)
+		{
+			louds_trie->select_samples[zeros / LOUDS_SELECT_SAMPLE] = (unsigned int)pos;
+		}
+		zeros++;
+		pos++;
+	}
+
+	assert((k == no_of_nodes) && (pos == louds_trie->louds_bits));
+
+	for (k = 0; k < words; k++)
+	{
+		louds_trie->terminal_ranks[k] = (unsigned int)louds_trie->no_of_words;
+		louds_trie->no_of_words += popCount(louds_trie->terminals[k]);
+	}
+
+	free(queue);
+
+	return RC_NO_ERROR;
+}
+
+LoudsNode LoudsTrie_FindChar (LoudsTrie *louds_trie, LoudsNode node, char ch)
+{
+	size_t start, end;
+	const char *found;
+
+	/* children of node are LOUDS positions start..end-1, their labels start at labels[start - node] */
+	start = (node == 0)? 0: (selectZero(louds_trie, node - 1) + 1);
+	end = nextZero(louds_trie, start);
+
+	found = (const char*)memchr(louds_trie->labels + (start - node), ch, end - start);
+	if (found == NULL)
+	{
+		return LOUDS_NO_NODE;
+	}
+
+	return (LoudsNode)((found - louds_trie->labels) + 1);
+}
+
+int LoudsTrie_IsWord (LoudsTrie *louds_trie, LoudsNode node)
+{
+	return (louds_trie->terminals[node / BITS_PER_WORD] >> (node % BITS_PER_WORD)) & 1;
+}
+
+int LoudsTrie_HasChildren (LoudsTrie *louds_trie, LoudsNode node)
+{
+	size_t start;
+
+	start = (node == 0)? 0: (selectZero(louds_trie, node - 1) + 1);
+
+	return (louds_trie->louds[start / BITS_PER_WORD] >> (start % BITS_PER_WORD)) & 1;
+}
+
+size_t LoudsTrie_WordIndex (LoudsTrie *louds_trie, LoudsNode node)
+{
+	assert(LoudsTrie_IsWord(louds_trie, node));
+
+	return louds_trie->terminal_ranks[node / BITS_PER_WORD] +
+		   popCount(louds_trie->terminals[node / BITS_PER_WORD] & ((1ULL << (node % BITS_PER_WORD)) - 1));
+}
+
+int LoudsTrie_FindWord (LoudsTrie *louds_trie, char *word)
+{
+	LoudsNode node = 0;
+
+	assert(word[0] != '\0');
+
+	for (; *word != '\0'; word++)
+	{
+		node = LoudsTrie_FindChar(louds_trie, node, *word);
+		if (node == LOUDS_NO_NODE)
+		{
+			return NOT_FOUND;
+		}
+	}
+
+	return LoudsTrie_IsWord(louds_trie, node)? WORD_FOUND: PREFIX_FOUND;
+}
+
+size_t LoudsTrie_Memory (LoudsTrie *louds_trie)
+{
+	size_t words = (louds_trie->no_of_nodes + BITS_PER_WORD - 1) / BITS_PER_WORD;
+
+	return (((louds_trie->louds_bits / BITS_PER_WORD) + 1) * sizeof(unsigned long long)) +
+		   (louds_trie->no_of_select_samples * sizeof(unsigned int)) + louds_trie->no_of_nodes +
+		   (words * (sizeof(unsigned long long) + sizeof(unsigned int)));
+}
+
+void LoudsTrie_Free (LoudsTrie *louds_trie)
+{
+	free(louds_trie->louds);
+	free(louds_trie->select_samples);
+	free(louds_trie->labels);
+	free(louds_trie->terminals);
+	free(louds_trie->terminal_ranks);
+
+	louds_trie->louds = NULL;
+	louds_trie->select_samples = NULL;
+	louds_trie->labels = NULL;
+	louds_trie->terminals = NULL;
+	louds_trie->terminal_ranks = NULL;
+}
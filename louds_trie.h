@@ -0,0 +1,169 @@
+#ifndef _LOUDS_TRIE_H_
+#define _LOUDS_TRIE_H_
+
+#include <stdio.h>
+#include "word_list.h"
+
+/* number of LOUDS 0 bits per select sample */
+#define LOUDS_SELECT_SAMPLE		64
+
+/* LOUDS trie node - node index in level order (0 is the root = empty prefix) */
+typedef unsigned int LoudsNode;
+
+#define LOUDS_NO_NODE		((LoudsNode)~0u)
+
+/* LOUDS trie struct - succinct (level-order unary degree sequence) encoding of a word list character tree:
+   a few bits per node instead of a (malloc'ed) character node with two pointers */
+typedef struct _LoudsTrie
+{
+	/* level-order unary degree sequence: for each node (in level order) a 1 bit per child and a 0 bit */
+	unsigned long long *louds;
+	size_t louds_bits;
+
+	/* position of every LOUDS_SELECT_SAMPLE-th 0 bit (select support) */
+	unsigned int *select_samples;
+	size_t no_of_select_samples;
+
+	/* label (character) of node k+1 is labels[k] - children of a node are consecutive */
+	char *labels;
+	size_t no_of_nodes;
+
+	/* terminal (is word) bit per node and number of terminal bits before every 64 bits word (rank support) */
+	unsigned long long *terminals;
+	unsigned int *terminal_ranks;
+
+	size_t no_of_words;
+
+} LoudsTrie;
+
+/***********************************************************************************************************************
+ *                                                                                                                     *
+ * FUNCTION: LoudsTrie_Build                                                                                           *
+ *                                                                                                                     *
+ * DESCRIPTION: build a LOUDS trie of the words of a word list                                                         *
+ *                                                                                                                     *
+ * PARAMETERS: louds_trie - (out) pointer to LOUDS trie                                                                *
+ *             word_list - (in) pointer to (built) word list                                                           *
+ *                                                                                                                     *
+ * RETURN: RC_NO_ERROR - no error                                                                                      *
+ *         RC_NO_MEM - no memory                                                                                       *
+ *                                                                                                                     *
+ * NOTES: the word list may be freed after the build                                                                   *
+ *                                                                                                                     *
+ ***********************************************************************************************************************/
+RETURN_CODE LoudsTrie_Build (LoudsTrie *louds_trie, WordList *word_list);
+
+/***********************************************************************************************************************
+ *                                                                                                                     *
+ * FUNCTION: LoudsTrie_FindChar                                                                                        *
+ *                                                                                                                     *
+ * DESCRIPTION: step one character down a LOUDS trie - find the child of a node with a given character                 *
+ *                                                                                                                     *
+ * PARAMETERS: louds_trie - (in) pointer to LOUDS trie                                                                 *
+ *             node - (in) node (prefix) to step from (0 for the root)                                                 *
+ *             ch - (in) character to find                                                                             *
+ *                                                                                                                     *
+ * RETURN: child node (or LOUDS_NO_NODE if node has no child with ch)                                                  *
+ *                                                                                                                     *
+ * NOTES:                                                                                                              *
+ *                                                                                                                     *
+ ***********************************************************************************************************************/
+LoudsNode LoudsTrie_FindChar (LoudsTrie *louds_trie, LoudsNode node, char ch);
+
+/***********************************************************************************************************************
+ *                                                                                                                     *
+ * FUNCTION: LoudsTrie_IsWord                                                                                          *
+ *                                                                                                                     *
+ * DESCRIPTION: is the prefix of a node a word                                                                         *
+ *                                                                                                                     *
+ * PARAMETERS: louds_trie - (in) pointer to LOUDS trie                                                                 *
+ *             node - (in) node                                                                                        *
+ *                                                                                                                     *
+ * RETURN: 1 - a word, 0 - not a word                                                                                  *
+ *                                                                                                                     *
+ * NOTES:                                                                                                              *
+ *                                                                                                                     *
+ ***********************************************************************************************************************/
+int LoudsTrie_IsWord (LoudsTrie *louds_trie, LoudsNode node);
+
+/***********************************************************************************************************************
+ *                                                                                                                     *
+ * FUNCTION: LoudsTrie_HasChildren                                                                                     *
+ *                                                                                                                     *
+ * DESCRIPTION: is the prefix of a node a prefix of longer words                                                       *
+ *                                                                                                                     *
+ * PARAMETERS: louds_trie - (in) pointer to LOUDS trie                                                                 *
+ *             node - (in) node                                                                                        *
+ *                                                                                                                     *
+ * RETURN: 1 - has children, 0 - a leaf                                                                                *
+ *                                                                                                                     *
+ * NOTES:                                                                                                              *
+ *                                                                                                                     *
+ ***********************************************************************************************************************/
+int LoudsTrie_HasChildren (LoudsTrie *louds_trie, LoudsNode node);
+
+/***********************************************************************************************************************
+ *                                                                                                                     *
+ * FUNCTION: LoudsTrie_WordIndex                                                                                       *
+ *                                                                                                                     *
+ * DESCRIPTION: dense index of a word node (number of word nodes before it in level order)                             *
+ *                                                                                                                     *
+ * PARAMETERS: louds_trie - (in) pointer to LOUDS trie                                                                 *
+ *             node - (in) word node                                                                                   *
+ *                                                                                                                     *
+ * RETURN: word index (0 .. no_of_words-1)                                                                             *
+ *                                                                                                                     *
+ * NOTES: a word index is not the word list word ID (words are numbered in level order, not in file order)             *
+ *                                                                                                                     *
+ ***********************************************************************************************************************/
+size_t LoudsTrie_WordIndex (LoudsTrie *louds_trie, LoudsNode node);
+
+/***********************************************************************************************************************
+ *                                                                                                                     *
+ * FUNCTION: LoudsTrie_FindWord                                                                                        *
+ *                                                                                                                     *
+ * DESCRIPTION: find a word (or prefix) in a LOUDS trie                                                                *
+ *                                                                                                                     *
+ * PARAMETERS: louds_trie - (in) pointer to LOUDS trie                                                                 *
+ *             word - (in) word to find (not empty)                                                                    *
+ *                                                                                                                     *
+ * RETURN: NOT_FOUND - word not found                                                                                  *
+ *         WORD_FOUND - word found                                                                                     *
+ *         PREFIX_FOUND - word found as a prefix of longer words                                                       *
+ *                                                                                                                     *
+ * NOTES:                                                                                                              *
+ *                                                                                                                     *
+ ***********************************************************************************************************************/
+int LoudsTrie_FindWord (LoudsTrie *louds_trie, char *word);
+
+/***********************************************************************************************************************
+ *                                                                                                                     *
+ * FUNCTION: LoudsTrie_Memory                                                                                          *
+ *                                                                                                                     *
+ * DESCRIPTION: memory of a LOUDS trie                                                                                 *
+ *                                                                                                                     *
+ * PARAMETERS: louds_trie - (in) pointer to LOUDS trie                                                                 *
+ *                                                                                                                     *
+ * RETURN: memory in bytes                                                                                             *
+ *                                                                                                                     *
+ * NOTES:                                                                                                              *
+ *                                                                                                                     *
+ ***********************************************************************************************************************/
+size_t LoudsTrie_Memory (LoudsTrie *louds_trie);
+
+/***********************************************************************************************************************
+ *                                                                                                                     *
+ * FUNCTION: LoudsTrie_Free                                                                                            *
+ *                                                                                                                     *
+ * DESCRIPTION: free memory dynamically allocated for LOUDS trie                                                       *
+ *                                                                                                                     *
+ * PARAMETERS: louds_trie - (in/out) pointer to LOUDS trie                                                             *
+ *                                                                                                                     *
+ * RETURN: none                                                                                                        *
+ *                                                                                                                     *
+ * NOTES:                                                                                                              *
+ *                                                                                                                     *
+ ***********************************************************************************************************************/
+void LoudsTrie_Free (LoudsTrie *louds_trie);
+
+#endif // _LOUDS_TRIE_H_
@@ -41,7 +41,7 @@ int main (int argc, char* argv[])
 		}
 		else
 		{
-			ret_code = WordsGrid_InitWordList(&words_grid, input_file);
+			ret_code = WordsGrid_LoadWordList(&words_grid, input_file, LOAD_NORMALIZE, NULL);
 
 			if (ret_code == RC_EOF)
 			{
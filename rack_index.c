@@ -0,0 +1,347 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+#include "gen_defs.h"
+#include "word_list.h"
+
+#include "rack_index.h"
+
+/*
+ CONCEPT: a word can be built from a rack only if its letter mask is a subset of the rack letter mask, so words are
+ grouped in buckets by letter mask. buckets are sorted by letter mask, so the buckets of one range share their high
+ mask bits: a range is split on its next (lower) bit and only the buckets with the bit clear are kept if the rack
+ has no such letter - the search visits only ranges of possible subsets and rejects a bucket with one AND.
+ the words of a possible bucket are checked by their twice/more masks (letters used more than once) - one AND each.
+
+ e.g. rack "tea" (mask {a,e,t}) finds the buckets {a}, {a,e}, {a,t}: at, ta, tat, {a,e,t}: ate, eat, tea, teat ...
+      and rejects tat and teat by their twice mask {t} ("tea" has one t)
+ */
+
+#define LETTER_MASK_BITS	27
+
+/* rack query */
+typedef struct _RackQuery
+{
+	RackIndex *rack_index;
+
+	/* rack letters: counts and masks of letters in the rack at least once, twice and 3 times */
+	unsigned char rack_counts[256];
+	unsigned int rack_mask;
+	unsigned int twice_mask;
+	unsigned int more_mask;
+
+	size_t max_results;
+	void (*match_func) (char *word, unsigned int word_id);
+	size_t no_of_words;
+
+} RackQuery;
+
+/*******************************************************************************************************************************************************/
+/************************************************************ internal functions declation *************************************************************/
+/*******************************************************************************************************************************************************/
+static int compareKeys (const void *key1, const void *key2);
+static void letterMasks (const char *word, unsigned char counts[256], unsigned int *twice_mask, unsigned int *more_mask);
+static int rackHasLetters (RackQuery *query, const char *word);
+static int searchBucket (RackQuery *query, RackBucket *bucket);
+static int searchBuckets (RackQuery *query, size_t first, size_t last, int bit);
+
+/*******************************************************************************************************************************************************/
+/************************************************************ internal functions definition ************************************************************/
+/*******************************************************************************************************************************************************/
+
+/***********************************************************************************************************************
+ *                                                                                                                     *
+ * FUNCTION: compareKeys                                                                                               *
+ *                                                                                                                     *
+ * DESCRIPTION: qsort compare function of word keys (letter mask and word ID)                                          *
+ *                                                                                                                     *
+ * PARAMETERS: key1, key2 - (in) pointers to keys                                                                      *
+ *                                                                                                                     *
+ * RETURN: <0, 0, >0                                                                                                   *
+ *                                                                                                                     *
+ * NOTES:                                                                                                              *
+ *                                                                                                                     *
+ ***********************************************************************************************************************/
+static int compareKeys (const void *key1, const void *key2)
+{
+	unsigned long long k1 = *(const unsigned long long*)key1;
+	unsigned long long k2 = *(const unsigned long long*)key2;
+
+	return (k1 > k2) - (k1 < k2);
+}
+
+/***********************************************************************************************************************
+ *                                                                                                                     *
+ * FUNCTION: letterMasks                                                                                               *
+ *                                                                                                                     *
+ * DESCRIPTION: letter counts and the masks of letters used twice and 3 times (or more) of a word (or rack)            *
+ *                                                                                                                     *
+ * PARAMETERS: word - (in) word                                                                                        *
+ *             counts - (out) count per character                                                                      *
+ *             twice_mask, more_mask - (out) letters used at least 2 and 3 times                                       *
+ *                                                                                                                     *
+ * RETURN: none                                                                                                        *
+ *                                                                                                                     *
+ * NOTES:                                                                                                              *
+ *                                                                                                                     *
+ ***********************************************************************************************************************/
+static void letterMasks (const char *word, unsigned char counts[256], unsigned int *twice_mask, unsigned int *more_mask)
+{
+	unsigned int letter_mask;
+
+	memset(counts, 0, 256);
+	*twice_mask = 0;
+	*more_mask = 0;
+
+	for (; *word != '\0'; word++)
+	{
+		letter_mask = ((*word >= 'a') && (*word <= 'z'))? (1u << (*word - 'a')): LETTER_MASK_OTHER;
+
+		counts[(unsigned char)(*word)]++;
+		if (counts[(unsigned char)(*word)] == 2)
+		{
+			*twice_mask |= letter_mask;
+		}
+		else if (counts[(unsigned char)(*word)] == 3)
+		{
+			*more_mask |= letter_mask;
+		}
+	}
+}
+
+/***********************************************************************************************************************
+ *                                                                                                                     *
+ * FUNCTION: rackHasLetters                                                                                            *
+ *                                                                                                                     *
+ * DESCRIPTION: are all the letters of a word in the rack (each rack letter used at most once)                         *
+ *                                                                                                                     *
+ * PARAMETERS: query - (in/out) pointer to rack query                                                                  *
+ *             word - (in) word                                                                                        *
+ *                                                                                                                     *
+ * RETURN: 1 - yes, 0 - no                                                                                             *
+ *                                                                                                                     *
+ * NOTES: the letters taken from the rack are put back after the check                                                 *
+ *                                                                                                                     *
+ ***********************************************************************************************************************/
+static int rackHasLetters (RackQuery *query, const char *word)
+{
+	const char *ch, *used;
+
+	for (ch = word; (*ch != '\0') && (query->rack_counts[(unsigned char)(*ch)] != 0); ch++)
+	{
+		query->rack_counts[(unsigned char)(*ch)]--;
+	}
+	for (used = word; used != ch; used++)
+	{
+		query->rack_counts[(unsigned char)(*used)]++;
+	}
+
+	return (*ch == '\0');
+}
+
+/***********************************************************************************************************************
+ *                                                                                                                     *
+ * FUNCTION: searchBucket                                                                                              *
+ *                                                                                                                     *
+ * DESCRIPTION: output the words of a bucket (of a rack letter mask subset) that can be built from the rack            *
+ *                                                                                                                     *
+ * PARAMETERS: query - (in/out) pointer to rack query                                                                  *
+ *             bucket - (in) pointer to bucket                                                                         *
+ *                                                                                                                     *
+ * RETURN: 1 - continue, 0 - stop (max_results words found)                                                            *
+ *                                                                                                                     *
+ * NOTES:                                                                                                              *
+ *                                                                                                                     *
+ ***********************************************************************************************************************/
+static int searchBucket (RackQuery *query, RackBucket *bucket)
+{
+	RackWord *rack_word;
+	char *word;
+	unsigned int k;
+
+	for (k = 0; k < bucket->count; k++)
+	{
+		rack_word = &(query->rack_index->words[bucket->start + k]);
+
+		if ((rack_word->twice_mask & ~query->twice_mask) || (rack_word->more_mask & ~query->more_mask))
+		{
+			continue;
+		}
+
+		word = WordList_GetWord(query->rack_index->word_list, rack_word->word_id);
+
+		/* letters 3 times or more (or not 'a'..'z') - check the letter counts */
+		if (((rack_word->more_mask != 0) || (bucket->letter_mask & LETTER_MASK_OTHER)) && !rackHasLetters(query, word))
+		{
+			continue;
+		}
+
+		query->match_func(word, rack_word->word_id);
+		if (++query->no_of_words == query->max_results)
+		{
+			return 0;
+		}
+	}
+
+	return 1;
+}
+
+/***********************************************************************************************************************
+ *                                                                                                                     *
+ * FUNCTION: searchBuckets                                                                                             *
+ *                                                                                                                     *
+ * DESCRIPTION: search a range of buckets (same letter mask bits above bit) for rack letter mask subsets               *
+ *                                                                                                                     *
+ * PARAMETERS: query - (in/out) pointer to rack query                                                                  *
+ *             first, last - (in) buckets range (first .. last-1)                                                      *
+ *             bit - (in) highest letter mask bit that may differ in the range                                         *
+ *                                                                                                                     *
+ * RETURN: 1 - continue, 0 - stop (max_results words found)                                                            *
+ *                                                                                                                     *
+ * NOTES:                                                                                                              *
+ *                                                                                                                     *
+ ***********************************************************************************************************************/
+static int searchBuckets (RackQuery *query, size_t first, size_t last, int bit)
+{
+	RackBucket *buckets = query->rack_index->buckets;
+	size_t split, low, high;
+
+	for (; (bit >= 0) && ((last - first) > 1); bit--)
+	{
+		/* split: first bucket with the bit set (binary search) */
+		for (low = first, high = last; low < high; )
+		{
+			split = low + ((high - low) / 2);
+			if (buckets[split].letter_mask & (1u << bit))
+			{
+				high = split;
+			}
+			else
+			{
+				low = split + 1;
+			}
+		}
+		split = low;
+
+		if (query->rack_mask & (1u << bit))
+		{
+			/* both halves - the bit clear half is searched first */
+			if ((split > first) && !searchBuckets(query, first, split, bit - 1))
+			{
+				return 0;
+			}
+			first = split;
+		}
+		else
+		{
+			last = split;
+		}
+	}
+
+	for (; first < last; first++)
+	{
+		if (!(buckets[first].letter_mask & ~query->rack_mask) && !searchBucket(query, &(buckets[first])))
+		{
+			return 0;
+		}
+	}
+
+	return 1;
+}
+
+/*******************************************************************************************************************************************************/
+/************************************************************ external functions definition ************************************************************/
+/*******************************************************************************************************************************************************/
+unsigned int RackIndex_LetterMask (const char *word)
+{
+	unsigned int letter_mask = 0;
+
+	for (; *word != '\0'; word++)
+	{
+		letter_mask |= ((*word >= 'a') && (*word <= 'z'))? (1u << (*word - 'a')): LETTER_MASK_OTHER;
+	}
+
+	return letter_mask;
+}
+
+RETURN_CODE RackIndex_Build (RackIndex *rack_index, WordList *word_list)
+{
+	unsigned long long *keys;
+	unsigned char counts[256];
+	RackBucket *bucket = NULL;
+	RackWord *rack_word;
+	unsigned int word_id, letter_mask;
+	size_t k;
+
+	memset(rack_index, 0, sizeof(RackIndex));
+	rack_index->word_list = word_list;
+
+	/* key: letter mask (high 32 bits) and word ID (low 32 bits) - sorted keys group the words by letter mask */
+	keys = (unsigned long long*)malloc((word_list->no_of_words + 1) * sizeof(unsigned long long));
+	rack_index->word_masks = (unsigned int*)malloc((word_list->no_of_words + 1) * sizeof(unsigned int));
+	rack_index->words = (RackWord*)malloc((word_list->no_of_words + 1) * sizeof(RackWord));
+	rack_index->buckets = (RackBucket*)malloc((word_list->no_of_words + 1) * sizeof(RackBucket));
+	if ((keys == NULL) || (rack_index->word_masks == NULL) || (rack_index->words == NULL) || (rack_index->buckets == NULL))
+	{
+		free(keys);
+		RackIndex_Free(rack_index);
+		return RC_NO_MEM;
+	}
+
+	for (word_id = 0; word_id < word_list->no_of_words; word_id++)
+	{
+		rack_index->word_masks[word_id] = RackIndex_LetterMask(WordList_GetWord(word_list, word_id));
+		keys[word_id] = ((unsigned long long)rack_index->word_masks[word_id] << 32) | word_id;
+	}
+	qsort(keys, word_list->no_of_words, sizeof(unsigned long long), compareKeys);
+
+	for (k = 0; k < word_list->no_of_words; k++)
+	{
+		letter_mask = (unsigned int)(keys[k] >> 32);
+		if ((bucket == NULL) || (bucket->letter_mask != letter_mask))
+		{
+			bucket = &(rack_index->buckets[rack_index->no_of_buckets++]);
+			bucket->letter_mask = letter_mask;
+			bucket->start = (unsigned int)k;
+			bucket->count = 0;
+		}
+		bucket->count++;
+
+		rack_word = &(rack_index->words[k]);
+		rack_word->word_id = (unsigned int)keys[k];
+		letterMasks(WordList_GetWord(word_list, rack_word->word_id), counts, &(rack_word->twice_mask), &(rack_word->more_mask));
+	}
+
+	free(keys);
+
+	return RC_NO_ERROR;
+}
+
+size_t RackIndex_FindWords (RackIndex *rack_index, const char *rack, size_t max_results, void (*match_func) (char *word, unsigned int word_id))
+{
+	RackQuery query;
+
+	query.rack_index = rack_index;
+	query.rack_mask = RackIndex_LetterMask(rack);
+	letterMasks(rack, query.rack_counts, &(query.twice_mask), &(query.more_mask));
+	query.max_results = max_results;
+	query.match_func = match_func;
+	query.no_of_words = 0;
+
+	searchBuckets(&query, 0, rack_index->no_of_buckets, LETTER_MASK_BITS - 1);
+
+	return query.no_of_words;
+}
+
+void RackIndex_Free (RackIndex *rack_index)
+{
+	free(rack_index->word_masks);
+	free(rack_index->words);
+	free(rack_index->buckets);
+
+	rack_index->word_masks = NULL;
+	rack_index->words = NULL;
+	rack_index->buckets = NULL;
+}
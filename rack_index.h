@@ -0,0 +1,112 @@
+#ifndef _RACK_INDEX_H_
+#define _RACK_INDEX_H_
+
+#include <stdio.h>
+#include "word_list.h"
+
+/* letter mask bits: a bit per letter 'a'..'z' and a bit for any other character */
+#define LETTER_MASK_OTHER		(1u << 26)
+
+/* rack index word - a word ID and the letters the word uses more than once */
+typedef struct _RackWord
+{
+	unsigned int word_id;
+	unsigned int twice_mask;	/* letters used 2 times or more */
+	unsigned int more_mask;		/* letters used 3 times or more (the word letter counts are checked if not 0) */
+
+} RackWord;
+
+/* rack index bucket - all words of one letter mask */
+typedef struct _RackBucket
+{
+	unsigned int letter_mask;
+	unsigned int start;		/* first word in words */
+	unsigned int count;		/* number of words */
+
+} RackBucket;
+
+/* rack index struct - words of a word list grouped by letter mask (the set of letters a word uses), so the words
+   that can be built from a rack of letters are found in the buckets of the rack letter mask subsets only */
+typedef struct _RackIndex
+{
+	WordList *word_list;
+
+	/* letter mask per word ID */
+	unsigned int *word_masks;
+
+	/* words grouped by letter mask */
+	RackWord *words;
+
+	/* buckets sorted by letter mask */
+	RackBucket *buckets;
+	size_t no_of_buckets;
+
+} RackIndex;
+
+/***********************************************************************************************************************
+ *                                                                                                                     *
+ * FUNCTION: RackIndex_LetterMask                                                                                      *
+ *                                                                                                                     *
+ * DESCRIPTION: letter mask of a word (or rack) - a bit per letter it uses                                             *
+ *                                                                                                                     *
+ * PARAMETERS: word - (in) word                                                                                        *
+ *                                                                                                                     *
+ * RETURN: letter mask                                                                                                 *
+ *                                                                                                                     *
+ * NOTES: a word whose mask has a bit out of the mask of a set of letters can not be built from them (one AND)         *
+ *                                                                                                                     *
+ ***********************************************************************************************************************/
+unsigned int RackIndex_LetterMask (const char *word);
+
+/***********************************************************************************************************************
+ *                                                                                                                     *
+ * FUNCTION: RackIndex_Build                                                                                           *
+ *                                                                                                                     *
+ * DESCRIPTION: build a rack index of the words of a word list                                                         *
+ *                                                                                                                     *
+ * PARAMETERS: rack_index - (out) pointer to rack index                                                                *
+ *             word_list - (in) pointer to (built) word list                                                           *
+ *                                                                                                                     *
+ * RETURN: RC_NO_ERROR - no error                                                                                      *
+ *         RC_NO_MEM - no memory                                                                                       *
+ *                                                                                                                     *
+ * NOTES: the word list must not be changed or freed during the rack index life time                                   *
+ *                                                                                                                     *
+ ***********************************************************************************************************************/
+RETURN_CODE RackIndex_Build (RackIndex *rack_index, WordList *word_list);
+
+/***********************************************************************************************************************
+ *                                                                                                                     *
+ * FUNCTION: RackIndex_FindWords                                                                                       *
+ *                                                                                                                     *
+ * DESCRIPTION: find all words that can be built from a rack of letters (each rack letter used at most once, in any    *
+ *              order)                                                                                                 *
+ *                                                                                                                     *
+ * PARAMETERS: rack_index - (in) pointer to rack index                                                                 *
+ *             rack - (in) rack letters e.g. "retains" (a letter may repeat)                                           *
+ *             max_results - (in) maximal number of words to find (0 for all)                                          *
+ *             match_func - (in) pointer to function called with each word found and its word ID                       *
+ *                                                                                                                     *
+ * RETURN: number of words found                                                                                       *
+ *                                                                                                                     *
+ * NOTES: visits only the buckets whose letter mask is a subset of the rack letter mask                                *
+ *                                                                                                                     *
+ ***********************************************************************************************************************/
+size_t RackIndex_FindWords (RackIndex *rack_index, const char *rack, size_t max_results, void (*match_func) (char *word, unsigned int word_id));
+
+/***********************************************************************************************************************
+ *                                                                                                                     *
+ * FUNCTION: RackIndex_Free                                                                                            *
+ *                                                                                                                     *
+ * DESCRIPTION: free memory dynamically allocated for rack index                                                       *
+ *                                                                                                                     *
+ * PARAMETERS: rack_index - (in/out) pointer to rack index                                                             *
+ *                                                                                                                     *
+ * RETURN: none                                                                                                        *
+ *                                                                                                                     *
+ * NOTES:                                                                                                              *
+ *                                                                                                                     *
+ ***********************************************************************************************************************/
+void RackIndex_Free (RackIndex *rack_index);
+
+#endif // _RACK_INDEX_H_
@@ -3,6 +3,15 @@
 #include <string.h>
 #include <assert.h>
 
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define WIDE_NODE_X86
+#include <immintrin.h>
+#endif
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
 #include "gen_defs.h"
 
 #include "word_list.h"
@@ -29,72 +38,363 @@
 			  l.->i->i.->s.    
  */
 
+/* normalized line length of a line skipped for invalid characters */
+#define LINE_SKIPPED	((size_t)~0)
+
+/* word list file reader - lines are read from the file in blocks and found in the block (no per line copy) */
+typedef struct _LineReader
+{
+	FILE *file;
+
+	/* block buffer: lines not read yet are buffer[start .. end-1] */
+	char buffer[READ_BLOCK_LEN];
+	size_t start;
+	size_t end;
+	int eof;
+
+} LineReader;
+
+/* suffix order sort key of a word (WordList_BuildSuffixOrder) */
+typedef struct _SuffixKey
+{
+	unsigned long long key;
+	unsigned int word_id;
+
+} SuffixKey;
+
 /*******************************************************************************************************************************************************/
 /************************************************************ internal functions declation *************************************************************/
 /*******************************************************************************************************************************************************/
-static RETURN_CODE readNextWordFromFile (FILE *file, char read_buffer[READ_BUF_SIZE], char *word);
-static RETURN_CODE addNewWordToCharTree (CharNode **char_tree, char *word, size_t *allocated_nodes);
+static void initLineReader (LineReader *reader, FILE *file);
+static RETURN_CODE readNextLine (LineReader *reader, char **line, size_t *line_len);
+static size_t normalizeLine (char *line, size_t line_len, unsigned int load_flags, WordListLoadStats *stats);
+static RETURN_CODE readNextWord (LineReader *reader, unsigned int load_flags, WordListLoadStats *stats, char *word);
+static void sortWordIds (CharNode *char_tree, unsigned int *word_offsets, unsigned int *sorted_offsets, unsigned int *word_id);
+static RETURN_CODE addNewWordToCharTree (CharNode **char_tree, char *word, unsigned int word_id, size_t *allocated_nodes, CharNode **word_node);
 static CharNode* newCharNode (CharNode **char_node, char ch, unsigned char is_word);
+static RETURN_CODE addWordToStringTable (WordList *word_list, char *word);
+static CharNode* newOverlayNode (WordListOverlay *overlay, CharNode *char_node, char ch);
+static RETURN_CODE copyOverlayPath (WordListOverlay *overlay, char *word, CharNode **word_node);
+static CharNode* findWideCharScalar (WideNode *wide_node, char ch);
+#ifdef WIDE_NODE_X86
+static CharNode* findWideCharSse2 (WideNode *wide_node, char ch);
+static CharNode* findWideCharAvx2 (WideNode *wide_node, char ch);
+#endif
+static void selectFindWideChar (void);
+static void buildWideNodes (CharNode **char_tree, size_t *wide_nodes);
+static RETURN_CODE levelOrderNodes (CharNode *char_tree, size_t no_of_nodes, CharNode ***nodes, unsigned int **first_child);
+static int compareNodeAddresses (const void *index1, const void *index2);
+static int compareListKeys (const void *key1, const void *key2);
+static unsigned long long patternClosure (WordPattern *pattern, unsigned long long states);
+static unsigned long long patternStep (WordPattern *pattern, unsigned long long states, char ch);
+static unsigned long long suffixKey (const char *word, size_t word_len);
+static int compareSuffixKeys (const void *key1, const void *key2);
+static size_t findSuffixKey (WordList *word_list, unsigned long long key);
+
+/* wide node character search (selected by the CPU at run time) */
+static CharNode* (*findWideChar) (WideNode *wide_node, char ch) = findWideCharScalar;
+
+/* nodes to sort by compareNodeAddresses (qsort has no context argument) */
+static CharNode **sort_nodes;
 
 /*******************************************************************************************************************************************************/
 /************************************************************ internal functions definition ************************************************************/
 /*******************************************************************************************************************************************************/
 /***********************************************************************************************************************
  *                                                                                                                     *
- * FUNCTION: readNextWordFromFile                                                                                      *
+ * FUNCTION: initLineReader                                                                                            *
  *                                                                                                                     *
- * DESCRIPTION: Called in a loop to read the next word from a word list file while                                     *
- *              buffering the read content into a read buffer                                                          *
+ * DESCRIPTION: initialise a word list file reader                                                                     *
  *                                                                                                                     *
- * PARAMETERS:  file - (in) pointer to (already open) word list input file                                             *
- *              read_buffer - (in/out) buffer to read the file content to                                              *
- *              word - (out) next word read                                                                            *
+ * PARAMETERS: reader - (out) pointer to reader                                                                        *
+ *             file - (in) pointer to (already open) word list input file                                              *
  *                                                                                                                     *
- * RETURN: RC_BAD_FORMAT - file format error                                                                           *
- *         RC_NO_ERROR - word found (no error)                                                                         *
- *         RC_EOF - end of file (no more words)                                                                        *
+ * RETURN: none                                                                                                        *
  *                                                                                                                     *
  * NOTES:                                                                                                              *
  *                                                                                                                     *
  ***********************************************************************************************************************/
- static RETURN_CODE readNextWordFromFile (FILE *file, char read_buffer[READ_BUF_SIZE], char *word)
+static void initLineReader (LineReader *reader, FILE *file)
+{
+	reader->file = file;
+	reader->start = 0;
+	reader->end = 0;
+	reader->eof = 0;
+}
+
+/***********************************************************************************************************************
+ *                                                                                                                     *
+ * FUNCTION: readNextLine                                                                                              *
+ *                                                                                                                     *
+ * DESCRIPTION: Called in a loop to read the next line from a word list file (reads the file a block at a time)        *
+ *                                                                                                                     *
+ * PARAMETERS: reader - (in/out) pointer to reader                                                                     *
+ *             line - (out) next line in the reader buffer (valid until the next call, may be changed) or NULL if      *
+ *                    the line is longer than READ_BLOCK_LEN                                                           *
+ *             line_len - (out) line length (with no LF)                                                               *
+ *                                                                                                                     *
+ * RETURN: RC_NO_ERROR - line read (no error)                                                                          *
+ *         RC_EOF - end of file (no more lines)                                                                        *
+ *                                                                                                                     *
+ * NOTES: the last line may have no LF                                                                                 *
+ *                                                                                                                     *
+ ***********************************************************************************************************************/
+static RETURN_CODE readNextLine (LineReader *reader, char **line, size_t *line_len)
 {
 	char *new_line_ptr;
-	size_t read_bytes, cur_length, word_len;
+	size_t read_bytes;
+	int overlong = 0;
 
-	new_line_ptr = strstr(read_buffer, "\n");
-	if (new_line_ptr == NULL)
+	for (;;)
 	{
-		/* read another block from file into read_buffer */
-		cur_length = strlen(read_buffer);
-		if ((cur_length +1 + READ_BLOCK_LEN) > READ_BUF_SIZE)
+		new_line_ptr = (char*)memchr(reader->buffer + reader->start, '\n', reader->end - reader->start);
+		if ((new_line_ptr != NULL) || (reader->eof && ((reader->start != reader->end) || overlong)))
 		{
-			return RC_BAD_FORMAT;
+			if (new_line_ptr == NULL)
+			{
+				/* last line with no LF */
+				new_line_ptr = reader->buffer + reader->end;
+			}
+
+			(*line) = overlong? NULL: (reader->buffer + reader->start);
+			(*line_len) = new_line_ptr - (reader->buffer + reader->start);
+			reader->start = (new_line_ptr < (reader->buffer + reader->end))? (size_t)((new_line_ptr + 1) - reader->buffer): reader->end;
+			return RC_NO_ERROR;
 		}
-		read_bytes = fread(read_buffer+strlen(read_buffer), 1, READ_BLOCK_LEN, file);
-		new_line_ptr = strstr(read_buffer, "\n");
-		if ((read_bytes == 0) || (new_line_ptr == NULL))
+
+		if (reader->eof)
 		{
 			return RC_EOF;
 		}
-		*(read_buffer+cur_length+read_bytes) = '\0';
-   }
 
-	/* check word length does not exceed maximum */
-	word_len = new_line_ptr - read_buffer;
-	if (word_len > MAX_WORD_LEN)
+		if ((reader->start == 0) && (reader->end == READ_BLOCK_LEN))
+		{
+			/* a line longer than the block is dropped up to its LF */
+			overlong = 1;
+			reader->end = 0;
+		}
+		else
+		{
+			/* keep the start of the next line and read another block after it */
+			memmove(reader->buffer, reader->buffer + reader->start, reader->end - reader->start);
+			reader->end -= reader->start;
+			reader->start = 0;
+		}
+
+		read_bytes = fread(reader->buffer + reader->end, 1, READ_BLOCK_LEN - reader->end, reader->file);
+		reader->end += read_bytes;
+		reader->eof = (read_bytes == 0);
+	}
+}
+
+/***********************************************************************************************************************
+ *                                                                                                                     *
+ * FUNCTION: normalizeLine                                                                                             *
+ *                                                                                                                     *
+ * DESCRIPTION: normalize a word list file line in place by load flags (strip CR, fold case, strip invalid             *
+ *              characters)                                                                                            *
+ *                                                                                                                     *
+ * PARAMETERS: line - (in/out) line                                                                                    *
+ *             line_len - (in) line length                                                                             *
+ *             load_flags - (in) LOAD_xxx flags                                                                        *
+ *             stats - (in/out) pointer to load statistics (folded, stripped and invalid words are counted)            *
+ *                                                                                                                     *
+ * RETURN: normalized line length (or LINE_SKIPPED - a word with invalid characters and LOAD_SKIP_INVALID)             *
+ *                                                                                                                     *
+ * NOTES: 16 characters are folded and checked at a time (SSE2) - a block of valid characters is stored as is          *
+ *                                                                                                                     *
+ ***********************************************************************************************************************/
+static size_t normalizeLine (char *line, size_t line_len, unsigned int load_flags, WordListLoadStats *stats)
+{
+	unsigned int check_invalid = load_flags & (LOAD_STRIP_INVALID | LOAD_SKIP_INVALID);
+	size_t in = 0, out = 0;
+	int folded = 0, stripped = 0;
+	char ch;
+#ifdef __SSE2__
+	__m128i chars, upper, valid;
+	unsigned int invalid_mask, k;
+	char block[16];
+#endif
+
+	if ((load_flags & LOAD_STRIP_CR) && (line_len > 0) && (line[line_len - 1] == '\r'))
 	{
-		return RC_BAD_FORMAT;
+		line_len--;
 	}
-   
-	/* copy next line into from read_buffer into line */
-	strncpy(word, read_buffer, new_line_ptr-read_buffer);
-	word[new_line_ptr-read_buffer] = '\0';
 
-	/* erase it from read_buffer - can be optimized */
-	memmove(read_buffer, new_line_ptr+1, strlen(new_line_ptr+1)+1);
-	
-	return RC_NO_ERROR;
+	if (!(load_flags & LOAD_FOLD_CASE) && !check_invalid)
+	{
+		return line_len;
+	}
+
+#ifdef __SSE2__
+	for (; (in + 16) <= line_len; in += 16)
+	{
+		chars = _mm_loadu_si128((const __m128i*)(line + in));
+
+		if (load_flags & LOAD_FOLD_CASE)
+		{
+			upper = _mm_and_si128(_mm_cmpgt_epi8(chars, _mm_set1_epi8('A' - 1)), _mm_cmplt_epi8(chars, _mm_set1_epi8('Z' + 1)));
+			folded |= (_mm_movemask_epi8(upper) != 0);
+			chars = _mm_or_si128(chars, _mm_and_si128(upper, _mm_set1_epi8('a' - 'A')));
+		}
+
+		valid = _mm_and_si128(_mm_cmpgt_epi8(chars, _mm_set1_epi8('a' - 1)), _mm_cmplt_epi8(chars, _mm_set1_epi8('z' + 1)));
+		invalid_mask = check_invalid? (~(unsigned int)_mm_movemask_epi8(valid) & 0xFFFFu): 0;
+
+		if (invalid_mask == 0)
+		{
+			/* out <= in - the store overwrites only characters already loaded */
+			_mm_storeu_si128((__m128i*)(line + out), chars);
+			out += 16;
+		}
+		else if (load_flags & LOAD_SKIP_INVALID)
+		{
+			stats->invalid_words++;
+			return LINE_SKIPPED;
+		}
+		else
+		{
+			_mm_storeu_si128((__m128i*)block, chars);
+			for (k = 0; k < 16; k++)
+			{
+				if (!(invalid_mask & (1u << k)))
+				{
+					line[out++] = block[k];
+				}
+			}
+			stripped = 1;
+		}
+	}
+#endif
+
+	for (; in < line_len; in++)
+	{
+		ch = line[in];
+		if ((load_flags & LOAD_FOLD_CASE) && (ch >= 'A') && (ch <= 'Z'))
+		{
+			ch = (char)(ch + ('a' - 'A'));
+			folded = 1;
+		}
+
+		if (check_invalid && ((ch < 'a') || (ch > 'z')))
+		{
+			if (load_flags & LOAD_SKIP_INVALID)
+			{
+				stats->invalid_words++;
+				return LINE_SKIPPED;
+			}
+			stripped = 1;
+			continue;
+		}
+
+		line[out++] = ch;
+	}
+
+	stats->folded_words += folded;
+	stats->stripped_words += stripped;
+
+	return out;
+}
+
+/***********************************************************************************************************************
+ *                                                                                                                     *
+ * FUNCTION: readNextWord                                                                                              *
+ *                                                                                                                     *
+ * DESCRIPTION: Called in a loop to read the next (normalized) word from a word list file - skips empty lines and      *
+ *              the lines skipped by load flags                                                                        *
+ *                                                                                                                     *
+ * PARAMETERS: reader - (in/out) pointer to reader                                                                     *
+ *             load_flags - (in) LOAD_xxx flags                                                                        *
+ *             stats - (in/out) pointer to load statistics                                                             *
+ *             word - (out) next word read                                                                             *
+ *                                                                                                                     *
+ * RETURN: RC_BAD_FORMAT - file format error (a word longer than MAX_WORD_LEN with no LOAD_SKIP_OVERLONG)              *
+ *         RC_NO_ERROR - word found (no error)                                                                         *
+ *         RC_EOF - end of file (no more words)                                                                        *
+ *                                                                                                                     *
+ * NOTES:                                                                                                              *
+ *                                                                                                                     *
+ ***********************************************************************************************************************/
+static RETURN_CODE readNextWord (LineReader *reader, unsigned int load_flags, WordListLoadStats *stats, char *word)
+{
+	char *line;
+	size_t line_len;
+	RETURN_CODE ret_code;
+
+	while ((ret_code = readNextLine(reader, &line, &line_len)) == RC_NO_ERROR)
+	{
+		stats->lines++;
+
+		if (line != NULL)
+		{
+			line_len = normalizeLine(line, line_len, load_flags, stats);
+			if (line_len == LINE_SKIPPED)
+			{
+				continue;
+			}
+		}
+
+		/* check word length does not exceed maximum */
+		if ((line == NULL) || (line_len > MAX_WORD_LEN))
+		{
+			if (!(load_flags & LOAD_SKIP_OVERLONG))
+			{
+				return RC_BAD_FORMAT;
+			}
+			stats->overlong_words++;
+			continue;
+		}
+
+		/* skip empty lines */
+		if (line_len == 0)
+		{
+			stats->empty_lines++;
+			continue;
+		}
+
+		memcpy(word, line, line_len);
+		word[line_len] = '\0';
+
+		return RC_NO_ERROR;
+	}
+
+	return ret_code;
+}
+
+/***********************************************************************************************************************
+ *                                                                                                                     *
+ * FUNCTION: sortWordIds                                                                                               *
+ *                                                                                                                     *
+ * DESCRIPTION: renumber the word IDs of a character tree in sorted word order (a word before its extensions, sibling  *
+ *              lists by character) and order the string table offsets by the new word IDs                             *
+ *                                                                                                                     *
+ * PARAMETERS: char_tree - (in/out) pointer to character tree (sibling list)                                           *
+ *             word_offsets - (in) string table offsets by the old word IDs                                            *
+ *             sorted_offsets - (out) string table offsets by the new word IDs                                         *
+ *             word_id - (in/out) next new word ID                                                                     *
+ *                                                                                                                     *
+ * RETURN: none                                                                                                        *
+ *                                                                                                                     *
+ * NOTES:                                                                                                              *
+ *                                                                                                                     *
+ ***********************************************************************************************************************/
+static void sortWordIds (CharNode *char_tree, unsigned int *word_offsets, unsigned int *sorted_offsets, unsigned int *word_id)
+{
+	CharNode *char_node;
+
+	for (char_node = char_tree; char_node != NULL; char_node = char_node->adjacent)
+	{
+		if (char_node->is_word)
+		{
+			sorted_offsets[*word_id] = word_offsets[char_node->word_id];
+			char_node->word_id = (*word_id)++;
+		}
+
+		if (char_node->next != NULL)
+		{
+			sortWordIds(char_node->next, word_offsets, sorted_offsets, word_id);
+		}
+	}
 }
 
 /***********************************************************************************************************************
@@ -120,6 +420,8 @@ static CharNode* newCharNode (CharNode **char_node, char ch, unsigned char is_wo
    {
 	  (*char_node)->ch = ch;
 	  (*char_node)->is_word = is_word;
+	  (*char_node)->flags = 0;
+	  (*char_node)->word_id = 0;
 	  (*char_node)->adjacent = NULL;
 	  (*char_node)->next = NULL;
    }
@@ -127,6 +429,7 @@ static CharNode* newCharNode (CharNode **char_node, char ch, unsigned char is_wo
    return (*char_node);
 }
 
+
 /***********************************************************************************************************************
  *                                                                                                                     *
  * FUNCTION: addNewWordToCharTree                                                                                      *
@@ -136,15 +439,17 @@ static CharNode* newCharNode (CharNode **char_node, char ch, unsigned char is_wo
  *                                                                                                                     *
  * PARAMETERS: char_tree - (in/out) pointer to character tree pointer                                                  *
  *             word  - (in) word to be added                                                                           *
+ *             word_id - (in) word ID to be set in the word's terminal character node                                  *
  *             allocated_nodes - (out) number of new nodes allocated as a result                                       *
+ *             word_node - (out) terminal character node of the word                                                   *
  *                                                                                                                     *
  * RETURN: RC_NO_ERROR - no error                                                                                      *
  *         RC_NO_MEM - error, no memory (nodes could not be allocated)                                                 *
  *                                                                                                                     *
- * NOTES:                                                                                                              *
+ * NOTES: a word that is already in the character tree keeps its word ID (word_node->word_id != word_id)               *
  *                                                                                                                     *
  ***********************************************************************************************************************/
-static RETURN_CODE addNewWordToCharTree (CharNode **char_tree, char *word, size_t *allocated_nodes)
+static RETURN_CODE addNewWordToCharTree (CharNode **char_tree, char *word, unsigned int word_id, size_t *allocated_nodes, CharNode **word_node)
 {
    CharNode *nxt_search = (*char_tree);
    CharNode *nxt_search_prev = NULL;
@@ -152,17 +457,18 @@ static RETURN_CODE addNewWordToCharTree (CharNode **char_tree, char *word, size_
    CharNode *adj_adj_search;
    CharNode *char_node;
    size_t i, word_len;
-   unsigned char is_word, char_added_to_adjacent;
+   unsigned char char_added_to_adjacent;
 
    word_len = strlen(word);
+   assert(word_len);
+
    for (i = 0; i < word_len; i++)
    {
-	  is_word = (i == (word_len - 1))? 1: 0;
-			   
+	  /* characters are added as non-words - the last character is marked as a word (with its word ID) at the end */
 	  /* no charaters exist in this depth */
 	  if (nxt_search == NULL)
 	  {
-		 char_node = newCharNode(&char_node, word[i], is_word);
+		 char_node = newCharNode(&char_node, word[i], 0);
 		 if (char_node == NULL)
 		 {
 			return RC_NO_MEM;
@@ -210,7 +516,7 @@ static RETURN_CODE addNewWordToCharTree (CharNode **char_tree, char *word, size_
 			   if (adj_adj_search == NULL)
 			   {
 				  /* add character to the end of ADJACENT list */
-				  char_node = newCharNode(&char_node, word[i], is_word);
+				  char_node = newCharNode(&char_node, word[i], 0);
 				  if (char_node == NULL)
 				  {
 					 return RC_NO_MEM;
@@ -227,7 +533,7 @@ static RETURN_CODE addNewWordToCharTree (CharNode **char_tree, char *word, size_
 			   else if (adj_adj_search->ch > (word[i]))
 			   {
 				  /* add character between adj_search and adj_adj_search */
-				  char_node = newCharNode(&char_node, word[i], is_word);
+				  char_node = newCharNode(&char_node, word[i], 0);
 				  if (char_node == NULL)
 				  {
 					 return RC_NO_MEM;
@@ -246,14 +552,22 @@ static RETURN_CODE addNewWordToCharTree (CharNode **char_tree, char *word, size_
 			else /* (adj_search->ch > (word[i])) */
 			{
 			   /* add character at the start of ADJACENT list */
-			   char_node = newCharNode(&char_node, word[i], is_word);
+			   char_node = newCharNode(&char_node, word[i], 0);
 			   if (char_node == NULL)
 			   {
 				  return RC_NO_MEM;
 			   }
 			   (*allocated_nodes)++;
 
-			   nxt_search_prev->next = char_node;
+			   /* the first tree level has no previous character node (an unsorted word list) */
+			   if (nxt_search_prev == NULL)
+			   {
+				  (*char_tree) = char_node;
+			   }
+			   else
+			   {
+				  nxt_search_prev->next = char_node;
+			   }
 			   char_node->adjacent = nxt_search;
 
 			   nxt_search_prev = char_node;
@@ -262,97 +576,1432 @@ static RETURN_CODE addNewWordToCharTree (CharNode **char_tree, char *word, size_
 			}
 		 }
 	  }
+   }
 
+   /* nxt_search_prev is the character node of the last word character (new or already in the tree) */
+   (*word_node) = nxt_search_prev;
+   if (!(*word_node)->is_word)
+   {
+	  (*word_node)->is_word = 1;
+	  (*word_node)->word_id = word_id;
    }
 
    return RC_NO_ERROR;
 }
 
-/*******************************************************************************************************************************************************/
-/************************************************************ external functions definition ************************************************************/
-/*******************************************************************************************************************************************************/
-RETURN_CODE WordList_BuildCharTree (WordList *word_list, FILE *file)
+/***********************************************************************************************************************
+ *                                                                                                                     *
+ * FUNCTION: addWordToStringTable                                                                                      *
+ *                                                                                                                     *
+ * DESCRIPTION: add a word string to the end of the word list string table (its word ID is word_list->no_of_words)     *
+ *                                                                                                                     *
+ * PARAMETERS: word_list - (in/out) pointer to word list                                                               *
+ *             word - (in) word to be added                                                                            *
+ *                                                                                                                     *
+ * RETURN: RC_NO_ERROR - no error                                                                                      *
+ *         RC_NO_MEM - error, no memory                                                                                *
+ *                                                                                                                     *
+ * NOTES: the string table is one blob of NUL terminated words and an array of word offsets into it                    *
+ *                                                                                                                     *
+ ***********************************************************************************************************************/
+static RETURN_CODE addWordToStringTable (WordList *word_list, char *word)
 {
-	char read_buffer[READ_BUF_SIZE] = {0};
-	char word[MAX_WORD_LEN+1];
-	RETURN_CODE ret_code;
+	size_t word_len = strlen(word);
+	size_t allocated;
+	void *ptr;
 
-	/* init word_list */ 
-	word_list->char_tree = NULL;
-	word_list->no_of_words = 0;
-	word_list->allocated_nodes = 0;
-	word_list->freed_nodes = 0;
+	if (word_list->no_of_words == word_list->allocated_word_offsets)
+	{
+		allocated = (word_list->allocated_word_offsets == 0)? 64: (2 * word_list->allocated_word_offsets);
+		ptr = realloc(word_list->word_offsets, allocated * sizeof(unsigned int));
+		if (ptr == NULL)
+		{
+			return RC_NO_MEM;
+		}
+		word_list->word_offsets = (unsigned int*)ptr;
+		word_list->allocated_word_offsets = allocated;
+	}
 
-	/* build word_list from file */
-	while ((ret_code = readNextWordFromFile(file, read_buffer, word)) == RC_NO_ERROR)
+	if ((word_list->word_strings_len + word_len + 1) > word_list->allocated_word_strings)
 	{
-	  ret_code = addNewWordToCharTree(&(word_list->char_tree), word, &(word_list->allocated_nodes));
-	  if (ret_code != RC_NO_ERROR)
-	  {
-		 break;
-	  }
-	  word_list->no_of_words++;
+		for (allocated = ((word_list->allocated_word_strings == 0)? 512: word_list->allocated_word_strings); allocated < (word_list->word_strings_len + word_len + 1); allocated *= 2);
+		ptr = realloc(word_list->word_strings, allocated);
+		if (ptr == NULL)
+		{
+			return RC_NO_MEM;
+		}
+		word_list->word_strings = (char*)ptr;
+		word_list->allocated_word_strings = allocated;
 	}
 
-	return ret_code;
+	word_list->word_offsets[word_list->no_of_words] = (unsigned int)word_list->word_strings_len;
+	memcpy(word_list->word_strings + word_list->word_strings_len, word, word_len + 1);
+	word_list->word_strings_len += word_len + 1;
+
+	return RC_NO_ERROR;
 }
 
-int WordList_FindWord (CharNode *char_tree, char *word)
+/***********************************************************************************************************************
+ *                                                                                                                     *
+ * FUNCTION: newOverlayNode                                                                                            *
+ *                                                                                                                     *
+ * DESCRIPTION: allocate a new character node owned by a word list overlay - a copy of a (base) character node or a    *
+ *              new (non-word, no NEXT and ADJACENT) character node                                                    *
+ *                                                                                                                     *
+ * PARAMETERS: overlay (in/out) - pointer to word list overlay                                                         *
+ *             char_node (in) - pointer to character node to copy (or NULL for a new character node)                   *
+ *             ch (in) - character of a new character node                                                             *
+ *                                                                                                                     *
+ * RETURN: pointer to the new char node (or NULL if could not be allocated)                                            *
+ *                                                                                                                     *
+ * NOTES:                                                                                                              *
+ *                                                                                                                     *
+ ***********************************************************************************************************************/
+static CharNode* newOverlayNode (WordListOverlay *overlay, CharNode *char_node, char ch)
 {
-   size_t word_len;
-   CharNode *search;
-   
-   word_len = strlen(word);
-
-   assert(word_len);
-   
-   for (search = char_tree; search != NULL; search = search->adjacent)
-   {
-	  if (search->ch == word[0])
-	  {
-		 if (word_len == 1)
-		 {
-			 if (search->is_word)
-			 {
-				 return WORD_FOUND;
-			 }
-			 else 
-			 {
-				 return PREFIX_FOUND;
-			 }
-		 }
-		 else
-		 {
-			return WordList_FindWord(search->next, word+1);
-		 }
-	  }
-	  else if (search->ch > word[0])
-	  {
-		 return NOT_FOUND;
-	  }
-	  /* else - search->ch < word[0] - continue */
-   }
+	CharNode *new_node;
+	CharNode **nodes;
+	size_t allocated;
 
-   return NOT_FOUND;
-}
+	if (overlay->no_of_nodes == overlay->allocated_nodes)
+	{
+		allocated = (overlay->allocated_nodes == 0)? 64: (2 * overlay->allocated_nodes);
+		nodes = (CharNode**)realloc(overlay->nodes, allocated * sizeof(CharNode*));
+		if (nodes == NULL)
+		{
+			return NULL;
+		}
+		overlay->nodes = nodes;
+		overlay->allocated_nodes = allocated;
+	}
 
-size_t WordList_FreeCharTree (CharNode *char_tree)
-{
-	size_t freed_nodes = 0;
-	
-	if (char_tree->next != NULL)
+	if (char_node != NULL)
 	{
-		freed_nodes += WordList_FreeCharTree(char_tree->next);
+		new_node = (CharNode*)malloc(sizeof(CharNode));
+		if (new_node != NULL)
+		{
+			/* a copy of a wide node head (or of a node arena node) is a plain character node */
+			*new_node = *char_node;
+			new_node->flags &= (unsigned char)~(NODE_WIDE | NODE_ARENA);
+		}
+	}
+	else
+	{
+		new_node = newCharNode(&new_node, ch, 0);
 	}
 
-	if (char_tree->adjacent != NULL)
+	if (new_node != NULL)
 	{
-		freed_nodes += WordList_FreeCharTree(char_tree->adjacent);
+		new_node->flags |= NODE_OVERLAY;
+		overlay->nodes[overlay->no_of_nodes++] = new_node;
 	}
 
-	char_tree->next = NULL;
-	char_tree->adjacent = NULL;
-	free(char_tree);
+	return new_node;
+}
 
-	return freed_nodes+1;
+/***********************************************************************************************************************
+ *                                                                                                                     *
+ * FUNCTION: copyOverlayPath                                                                                           *
+ *                                                                                                                     *
+ * DESCRIPTION: make the path of a word in an overlay character tree owned by the overlay: every base node on the      *
+ *              path (and every base node before it in its ADJACENT list) is replaced by an overlay copy, and          *
+ *              missing characters are added, so the word's nodes can be changed without changing the base             *
+ *                                                                                                                     *
+ * PARAMETERS: overlay (in/out) - pointer to word list overlay                                                         *
+ *             word (in) - word                                                                                        *
+ *             word_node (out) - terminal character node of the word (owned by the overlay)                            *
+ *                                                                                                                     *
+ * RETURN: RC_NO_ERROR - no error                                                                                      *
+ *         RC_NO_MEM - no memory                                                                                       *
+ *                                                                                                                     *
+ * NOTES: e.g. adding "aab" to the tree in the concept note above copies Head->a->a. and sets the copy's NEXT to a     *
+ *        new b node whose ADJACENT is the base node h. (h., l. and all nodes below them are shared, not copied)       *
+ *        the nodes before a copied node in its sibling list are copied too - the link to it is in the node before     *
+ *        it (a singly linked list); later words under the same lists reuse the copies, so the cost per changed        *
+ *        word falls as the overlay grows (WordListOverlay_AddWord)                                                    *
+ *                                                                                                                     *
+ ***********************************************************************************************************************/
+static RETURN_CODE copyOverlayPath (WordListOverlay *overlay, char *word, CharNode **word_node)
+{
+	CharNode **link = &(overlay->char_tree);
+	CharNode *char_node = NULL;
+	size_t i, word_len;
+
+	word_len = strlen(word);
+	for (i = 0; i < word_len; i++)
+	{
+		/* ADJACENT list is kept sorted by character value - every link changed on the way must be owned */
+		while (((*link) != NULL) && ((*link)->ch < word[i]))
+		{
+			if (!((*link)->flags & NODE_OVERLAY))
+			{
+				if (((*link) = newOverlayNode(overlay, (*link), 0)) == NULL)
+				{
+					return RC_NO_MEM;
+				}
+			}
+			link = &((*link)->adjacent);
+		}
+
+		if (((*link) != NULL) && ((*link)->ch == word[i]))
+		{
+			if (!((*link)->flags & NODE_OVERLAY))
+			{
+				if (((*link) = newOverlayNode(overlay, (*link), 0)) == NULL)
+				{
+					return RC_NO_MEM;
+				}
+			}
+			char_node = (*link);
+		}
+		else
+		{
+			char_node = newOverlayNode(overlay, NULL, word[i]);
+			if (char_node == NULL)
+			{
+				return RC_NO_MEM;
+			}
+			char_node->adjacent = (*link);
+			(*link) = char_node;
+		}
+
+		link = &(char_node->next);
+	}
+
+	(*word_node) = char_node;
+
+	return RC_NO_ERROR;
+}
+
+/***********************************************************************************************************************
+ *                                                                                                                     *
+ * FUNCTION: findWideCharScalar                                                                                        *
+ *                                                                                                                     *
+ * DESCRIPTION: find a character in a wide node (one character at a time)                                              *
+ *                                                                                                                     *
+ * PARAMETERS: wide_node (in) - pointer to wide node                                                                   *
+ *             ch (in) - character to find                                                                             *
+ *                                                                                                                     *
+ * RETURN: pointer to character node of ch (or NULL if not found)                                                      *
+ *                                                                                                                     *
+ * NOTES: fallback of CPUs with no vector compare                                                                      *
+ *                                                                                                                     *
+ ***********************************************************************************************************************/
+static CharNode* findWideCharScalar (WideNode *wide_node, char ch)
+{
+	const char *found;
+
+	found = (const char*)memchr(wide_node->chars, ch, WIDE_NODE_MAX_CHARS);
+
+	/* a padding 0 character finds a NULL node */
+	return (found != NULL)? wide_node->char_nodes[found - wide_node->chars]: NULL;
+}
+
+#ifdef WIDE_NODE_X86
+/***********************************************************************************************************************
+ *                                                                                                                     *
+ * FUNCTION: findWideCharSse2                                                                                          *
+ *                                                                                                                     *
+ * DESCRIPTION: find a character in a wide node (SSE2 - two 16 characters compares)                                    *
+ *                                                                                                                     *
+ * PARAMETERS: wide_node (in) - pointer to wide node                                                                   *
+ *             ch (in) - character to find                                                                             *
+ *                                                                                                                     *
+ * RETURN: pointer to character node of ch (or NULL if not found)                                                      *
+ *                                                                                                                     *
+ * NOTES:                                                                                                              *
+ *                                                                                                                     *
+ ***********************************************************************************************************************/
+__attribute__((target("sse2")))
+static CharNode* findWideCharSse2 (WideNode *wide_node, char ch)
+{
+	__m128i key = _mm_set1_epi8(ch);
+	unsigned int mask;
+
+	mask = (unsigned int)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*)wide_node->chars), key)) |
+		   ((unsigned int)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*)(wide_node->chars + 16)), key)) << 16);
+
+	/* a padding 0 character finds a NULL node */
+	return (mask != 0)? wide_node->char_nodes[__builtin_ctz(mask)]: NULL;
+}
+
+/***********************************************************************************************************************
+ *                                                                                                                     *
+ * FUNCTION: findWideCharAvx2                                                                                          *
+ *                                                                                                                     *
+ * DESCRIPTION: find a character in a wide node (AVX2 - one 32 characters compare)                                     *
+ *                                                                                                                     *
+ * PARAMETERS: wide_node (in) - pointer to wide node                                                                   *
+ *             ch (in) - character to find                                                                             *
+ *                                                                                                                     *
+ * RETURN: pointer to character node of ch (or NULL if not found)                                                      *
+ *                                                                                                                     *
+ * NOTES:                                                                                                              *
+ *                                                                                                                     *
+ ***********************************************************************************************************************/
+__attribute__((target("avx2")))
+static CharNode* findWideCharAvx2 (WideNode *wide_node, char ch)
+{
+	unsigned int mask;
+
+	mask = (unsigned int)_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i*)wide_node->chars), _mm256_set1_epi8(ch)));
+
+	/* a padding 0 character finds a NULL node */
+	return (mask != 0)? wide_node->char_nodes[__builtin_ctz(mask)]: NULL;
+}
+#endif // WIDE_NODE_X86
+
+/***********************************************************************************************************************
+ *                                                                                                                     *
+ * FUNCTION: selectFindWideChar                                                                                        *
+ *                                                                                                                     *
+ * DESCRIPTION: select the wide node character search of the running CPU (AVX2, SSE2 or scalar)                        *
+ *                                                                                                                     *
+ * PARAMETERS: none                                                                                                    *
+ *                                                                                                                     *
+ * RETURN: none                                                                                                        *
+ *                                                                                                                     *
+ * NOTES: one binary runs on any x86 CPU (and any other CPU with the scalar search)                                    *
+ *                                                                                                                     *
+ ***********************************************************************************************************************/
+static void selectFindWideChar (void)
+{
+#ifdef WIDE_NODE_X86
+	__builtin_cpu_init();
+
+	if (__builtin_cpu_supports("avx2"))
+	{
+		findWideChar = findWideCharAvx2;
+	}
+	else if (__builtin_cpu_supports("sse2"))
+	{
+		findWideChar = findWideCharSse2;
+	}
+	else
+#endif
+	{
+		findWideChar = findWideCharScalar;
+	}
+}
+
+/***********************************************************************************************************************
+ *                                                                                                                     *
+ * FUNCTION: buildWideNodes                                                                                            *
+ *                                                                                                                     *
+ * DESCRIPTION: replace the head of every sibling list of WIDE_NODE_MIN_CHARS..WIDE_NODE_MAX_CHARS character nodes     *
+ *              in a character tree by a wide node                                                                     *
+ *                                                                                                                     *
+ * PARAMETERS: char_tree (in/out) - pointer to link to character tree (sibling list)                                   *
+ *             wide_nodes (in/out) - number of wide nodes                                                              *
+ *                                                                                                                     *
+ * RETURN: none                                                                                                        *
+ *                                                                                                                     *
+ * NOTES: a sibling list stays a plain list if no memory (wide nodes only speed up the search)                         *
+ *                                                                                                                     *
+ ***********************************************************************************************************************/
+static void buildWideNodes (CharNode **char_tree, size_t *wide_nodes)
+{
+	WideNode *wide_node;
+	CharNode *char_node;
+	size_t no_of_chars = 0;
+
+	for (char_node = (*char_tree); char_node != NULL; char_node = char_node->adjacent)
+	{
+		if (char_node->next != NULL)
+		{
+			buildWideNodes(&(char_node->next), wide_nodes);
+		}
+		no_of_chars++;
+	}
+
+	if ((no_of_chars < WIDE_NODE_MIN_CHARS) || (no_of_chars > WIDE_NODE_MAX_CHARS) || ((*char_tree)->flags & (NODE_WIDE | NODE_ARENA)))
+	{
+		return;
+	}
+
+	wide_node = (WideNode*)calloc(1, sizeof(WideNode));
+	if (wide_node == NULL)
+	{
+		return;
+	}
+
+	wide_node->head = *(*char_tree);
+	wide_node->head.flags |= NODE_WIDE;
+	free(*char_tree);
+	(*char_tree) = &(wide_node->head);
+
+	no_of_chars = 0;
+	for (char_node = (*char_tree); char_node != NULL; char_node = char_node->adjacent)
+	{
+		wide_node->chars[no_of_chars] = char_node->ch;
+		wide_node->char_nodes[no_of_chars] = char_node;
+		no_of_chars++;
+	}
+
+	(*wide_nodes)++;
+}
+
+/***********************************************************************************************************************
+ *                                                                                                                     *
+ * FUNCTION: levelOrderNodes                                                                                           *
+ *                                                                                                                     *
+ * DESCRIPTION: list the character nodes of a character tree in level order (breadth first)                            *
+ *                                                                                                                     *
+ * PARAMETERS: char_tree (in) - pointer to character tree                                                              *
+ *             no_of_nodes (in) - number of nodes in the character tree                                                *
+ *             nodes (out) - nodes in level order (allocated - the caller frees it)                                    *
+ *             first_child (out) - level order index of the first child of each node or NO_NODE_INDEX (allocated)      *
+ *                                                                                                                     *
+ * RETURN: RC_NO_ERROR - no error                                                                                      *
+ *         RC_NO_MEM - no memory                                                                                       *
+ *                                                                                                                     *
+ * NOTES: siblings are consecutive in level order - the adjacent node of node k is node k+1                            *
+ *                                                                                                                     *
+ ***********************************************************************************************************************/
+static RETURN_CODE levelOrderNodes (CharNode *char_tree, size_t no_of_nodes, CharNode ***nodes, unsigned int **first_child)
+{
+	CharNode *char_node;
+	size_t k, tail = 0;
+
+	(*nodes) = (CharNode**)malloc((no_of_nodes + 1) * sizeof(CharNode*));
+	(*first_child) = (unsigned int*)malloc((no_of_nodes + 1) * sizeof(unsigned int));
+	if (((*nodes) == NULL) || ((*first_child) == NULL))
+	{
+		free(*nodes);
+		free(*first_child);
+		(*nodes) = NULL;
+		(*first_child) = NULL;
+		return RC_NO_MEM;
+	}
+
+	for (char_node = char_tree; char_node != NULL; char_node = char_node->adjacent)
+	{
+		(*nodes)[tail++] = char_node;
+	}
+
+	for (k = 0; k < tail; k++)
+	{
+		(*first_child)[k] = ((*nodes)[k]->next != NULL)? (unsigned int)tail: NO_NODE_INDEX;
+		for (char_node = (*nodes)[k]->next; char_node != NULL; char_node = char_node->adjacent)
+		{
+			assert(tail < no_of_nodes);
+			(*nodes)[tail++] = char_node;
+		}
+	}
+	assert(tail == no_of_nodes);
+
+	return RC_NO_ERROR;
+}
+
+/***********************************************************************************************************************
+ *                                                                                                                     *
+ * FUNCTION: compareNodeAddresses                                                                                      *
+ *                                                                                                                     *
+ * DESCRIPTION: qsort compare function of level order indices by the address of their nodes (in sort_nodes)            *
+ *                                                                                                                     *
+ * PARAMETERS: index1, index2 (in) - pointers to level order indices                                                   *
+ *                                                                                                                     *
+ * RETURN: <0, 0, >0                                                                                                   *
+ *                                                                                                                     *
+ * NOTES:                                                                                                              *
+ *                                                                                                                     *
+ ***********************************************************************************************************************/
+static int compareNodeAddresses (const void *index1, const void *index2)
+{
+	CharNode *node1 = sort_nodes[*(const unsigned int*)index1];
+	CharNode *node2 = sort_nodes[*(const unsigned int*)index2];
+
+	return (node1 > node2) - (node1 < node2);
+}
+
+/***********************************************************************************************************************
+ *                                                                                                                     *
+ * FUNCTION: compareListKeys                                                                                           *
+ *                                                                                                                     *
+ * DESCRIPTION: qsort compare function of sibling list keys (inverted access count and level order index)              *
+ *                                                                                                                     *
+ * PARAMETERS: key1, key2 (in) - pointers to keys                                                                      *
+ *                                                                                                                     *
+ * RETURN: <0, 0, >0                                                                                                   *
+ *                                                                                                                     *
+ * NOTES:                                                                                                              *
+ *                                                                                                                     *
+ ***********************************************************************************************************************/
+static int compareListKeys (const void *key1, const void *key2)
+{
+	unsigned long long k1 = *(const unsigned long long*)key1;
+	unsigned long long k2 = *(const unsigned long long*)key2;
+
+	return (k1 > k2) - (k1 < k2);
+}
+
+/***********************************************************************************************************************
+ *                                                                                                                     *
+ * FUNCTION: patternClosure                                                                                            *
+ *                                                                                                                     *
+ * DESCRIPTION: add to a set of pattern states the states after their PATTERN_ANY_CHARS elements (which match 0        *
+ *              characters too)                                                                                        *
+ *                                                                                                                     *
+ * PARAMETERS: pattern (in) - pointer to word pattern                                                                  *
+ *             states (in) - set of states                                                                             *
+ *                                                                                                                     *
+ * RETURN: set of states                                                                                               *
+ *                                                                                                                     *
+ * NOTES:                                                                                                              *
+ *                                                                                                                     *
+ ***********************************************************************************************************************/
+static unsigned long long patternClosure (WordPattern *pattern, unsigned long long states)
+{
+	unsigned long long new_states;
+
+	while ((new_states = ((states & pattern->any_chars_states) << 1) & ~states) != 0)
+	{
+		states |= new_states;
+	}
+
+	return states;
+}
+
+/***********************************************************************************************************************
+ *                                                                                                                     *
+ * FUNCTION: patternStep                                                                                               *
+ *                                                                                                                     *
+ * DESCRIPTION: step a set of pattern states on a character                                                            *
+ *                                                                                                                     *
+ * PARAMETERS: pattern (in) - pointer to word pattern                                                                  *
+ *             states (in) - set of states (closed)                                                                    *
+ *             ch (in) - character                                                                                     *
+ *                                                                                                                     *
+ * RETURN: set of states after ch (closed) - 0 if no state matches ch                                                  *
+ *                                                                                                                     *
+ * NOTES: a one character element moves on to the next element, a PATTERN_ANY_CHARS element stays                      *
+ *                                                                                                                     *
+ ***********************************************************************************************************************/
+static unsigned long long patternStep (WordPattern *pattern, unsigned long long states, char ch)
+{
+	states = ((states & pattern->char_states[(unsigned char)ch]) << 1) | (states & pattern->any_chars_states);
+
+	return patternClosure(pattern, states);
+}
+
+/***********************************************************************************************************************
+ *                                                                                                                     *
+ * FUNCTION: suffixKey                                                                                                 *
+ *                                                                                                                     *
+ * DESCRIPTION: suffix order key of a word - its last SUFFIX_KEY_LEN characters reversed, the last character in the    *
+ *              most significant byte (and 0 bytes after the first character of a shorter word)                        *
+ *                                                                                                                     *
+ * PARAMETERS: word (in) - word                                                                                        *
+ *             word_len (in) - word length                                                                             *
+ *                                                                                                                     *
+ * RETURN: suffix order key                                                                                            *
+ *                                                                                                                     *
+ * NOTES: e.g. "sing" is 'g','n','i','s',0,0,0,0 - the keys of the words that end with "ing" are one range             *
+ *                                                                                                                     *
+ ***********************************************************************************************************************/
+static unsigned long long suffixKey (const char *word, size_t word_len)
+{
+	unsigned long long key = 0;
+	size_t k;
+
+	for (k = 0; k < SUFFIX_KEY_LEN; k++)
+	{
+		key = (key << 8) | ((k < word_len)? (unsigned char)word[word_len - 1 - k]: 0);
+	}
+
+	return key;
+}
+
+/***********************************************************************************************************************
+ *                                                                                                                     *
+ * FUNCTION: compareSuffixKeys                                                                                         *
+ *                                                                                                                     *
+ * DESCRIPTION: qsort compare function of suffix order keys (and word IDs of equal keys)                               *
+ *                                                                                                                     *
+ * PARAMETERS: key1, key2 (in) - pointers to SuffixKey                                                                 *
+ *                                                                                                                     *
+ * RETURN: <0, 0, >0                                                                                                   *
+ *                                                                                                                     *
+ * NOTES:                                                                                                              *
+ *                                                                                                                     *
+ ***********************************************************************************************************************/
+static int compareSuffixKeys (const void *key1, const void *key2)
+{
+	const SuffixKey *k1 = (const SuffixKey*)key1;
+	const SuffixKey *k2 = (const SuffixKey*)key2;
+
+	if (k1->key != k2->key)
+	{
+		return (k1->key > k2->key) - (k1->key < k2->key);
+	}
+
+	return (k1->word_id > k2->word_id) - (k1->word_id < k2->word_id);
+}
+
+/***********************************************************************************************************************
+ *                                                                                                                     *
+ * FUNCTION: findSuffixKey                                                                                             *
+ *                                                                                                                     *
+ * DESCRIPTION: find the first word of the suffix order whose key is not less than a key (binary search)               *
+ *                                                                                                                     *
+ * PARAMETERS: word_list (in) - pointer to word list (with a suffix order)                                             *
+ *             key (in) - suffix order key                                                                             *
+ *                                                                                                                     *
+ * RETURN: suffix order index (no_of_words if all keys are less than key)                                              *
+ *                                                                                                                     *
+ * NOTES:                                                                                                              *
+ *                                                                                                                     *
+ ***********************************************************************************************************************/
+static size_t findSuffixKey (WordList *word_list, unsigned long long key)
+{
+	size_t low = 0, high = word_list->no_of_words, middle;
+	char *word;
+
+	while (low < high)
+	{
+		middle = low + ((high - low) / 2);
+		word = WordList_GetWord(word_list, word_list->suffix_order[middle]);
+		if (suffixKey(word, strlen(word)) < key)
+		{
+			low = middle + 1;
+		}
+		else
+		{
+			high = middle;
+		}
+	}
+
+	return low;
+}
+
+/*******************************************************************************************************************************************************/
+/************************************************************ external functions definition ************************************************************/
+/*******************************************************************************************************************************************************/
+RETURN_CODE WordList_BuildCharTree (WordList *word_list, FILE *file)
+{
+	return WordList_LoadCharTree(word_list, file, 0, NULL);
+}
+
+RETURN_CODE WordList_LoadCharTree (WordList *word_list, FILE *file, unsigned int load_flags, WordListLoadStats *stats)
+{
+	LineReader *reader;
+	WordListLoadStats load_stats;
+	char word[MAX_WORD_LEN+1];
+	CharNode *word_node;
+	unsigned int *sorted_offsets, word_id = 0;
+	RETURN_CODE ret_code;
+
+	if (stats == NULL)
+	{
+		stats = &load_stats;
+	}
+	memset(stats, 0, sizeof(WordListLoadStats));
+
+	/* init word_list */ 
+	word_list->char_tree = NULL;
+	word_list->no_of_words = 0;
+	word_list->allocated_nodes = 0;
+	word_list->freed_nodes = 0;
+	word_list->wide_nodes = 0;
+	word_list->node_arena = NULL;
+	word_list->node_arena_size = 0;
+	word_list->word_strings = NULL;
+	word_list->word_strings_len = 0;
+	word_list->allocated_word_strings = 0;
+	word_list->word_offsets = NULL;
+	word_list->allocated_word_offsets = 0;
+	word_list->suffix_order = NULL;
+	word_list->suffix_word_lens = NULL;
+
+	/* the reader block is too big for the stack */
+	reader = (LineReader*)malloc(sizeof(LineReader));
+	if (reader == NULL)
+	{
+		return RC_NO_MEM;
+	}
+	initLineReader(reader, file);
+
+	/* build word_list from file */
+	while ((ret_code = readNextWord(reader, load_flags, stats, word)) == RC_NO_ERROR)
+	{
+	  ret_code = addNewWordToCharTree(&(word_list->char_tree), word, (unsigned int)word_list->no_of_words, &(word_list->allocated_nodes), &word_node);
+	  if (ret_code != RC_NO_ERROR)
+	  {
+		 break;
+	  }
+
+	  /* a duplicated word keeps its first word ID */
+	  if (word_node->word_id == word_list->no_of_words)
+	  {
+		 ret_code = addWordToStringTable(word_list, word);
+		 if (ret_code != RC_NO_ERROR)
+		 {
+			break;
+		 }
+		 word_list->no_of_words++;
+	  }
+	  else
+	  {
+		 stats->duplicate_words++;
+	  }
+	}
+	stats->words = word_list->no_of_words;
+	free(reader);
+
+	/* word IDs in sorted order: the string table offsets are reordered (the strings stay in place) */
+	if ((ret_code == RC_EOF) && (load_flags & LOAD_SORT) && (word_list->char_tree != NULL))
+	{
+		sorted_offsets = (unsigned int*)malloc(word_list->allocated_word_offsets * sizeof(unsigned int));
+		if (sorted_offsets == NULL)
+		{
+			return RC_NO_MEM;
+		}
+		sortWordIds(word_list->char_tree, word_list->word_offsets, sorted_offsets, &word_id);
+		free(word_list->word_offsets);
+		word_list->word_offsets = sorted_offsets;
+	}
+
+	/* wide nodes are built once the tree is complete (sibling lists keep changing while words are added) */
+	if ((ret_code == RC_EOF) && (word_list->char_tree != NULL))
+	{
+		selectFindWideChar();
+		buildWideNodes(&(word_list->char_tree), &(word_list->wide_nodes));
+	}
+
+	return ret_code;
+}
+
+int WordList_FindWord (CharNode *char_tree, char *word)
+{
+   CharNode *search = NULL;
+
+   assert(word[0] != '\0');
+
+   for (; *word != '\0'; word++)
+   {
+	  search = WordList_FindChar(char_tree, *word);
+	  if (search == NULL)
+	  {
+		 return NOT_FOUND;
+	  }
+	  char_tree = search->next;
+   }
+
+   return search->is_word? WORD_FOUND: PREFIX_FOUND;
+}
+
+CharNode* WordList_FindChar (CharNode *char_tree, char ch)
+{
+   CharNode *search;
+
+   if ((char_tree != NULL) && (char_tree->flags & NODE_WIDE))
+   {
+	  return findWideChar((WideNode*)char_tree, ch);
+   }
+
+   for (search = char_tree; search != NULL; search = search->adjacent)
+   {
+	  if (search->ch == ch)
+	  {
+		 return search;
+	  }
+	  else if (search->ch > ch)
+	  {
+		 return NULL;
+	  }
+	  /* else - search->ch < ch - continue */
+   }
+
+   return NULL;
+}
+
+char* WordList_GetWord (WordList *word_list, unsigned int word_id)
+{
+   assert(word_id < word_list->no_of_words);
+
+   return word_list->word_strings + word_list->word_offsets[word_id];
+}
+
+size_t WordList_FreeCharTree (CharNode *char_tree)
+{
+	size_t freed_nodes = 0;
+	
+	if (char_tree->next != NULL)
+	{
+		freed_nodes += WordList_FreeCharTree(char_tree->next);
+	}
+
+	if (char_tree->adjacent != NULL)
+	{
+		freed_nodes += WordList_FreeCharTree(char_tree->adjacent);
+	}
+
+	char_tree->next = NULL;
+	char_tree->adjacent = NULL;
+	if (!(char_tree->flags & NODE_ARENA))
+	{
+		free(char_tree);
+	}
+
+	return freed_nodes+1;
+}
+
+void WordList_Free (WordList *word_list)
+{
+	if (word_list->char_tree != NULL)
+	{
+		word_list->freed_nodes = WordList_FreeCharTree(word_list->char_tree);
+		word_list->char_tree = NULL;
+	}
+
+	free(word_list->node_arena);
+	free(word_list->word_strings);
+	free(word_list->word_offsets);
+	free(word_list->suffix_order);
+	free(word_list->suffix_word_lens);
+
+	word_list->node_arena = NULL;
+	word_list->node_arena_size = 0;
+	word_list->word_strings = NULL;
+	word_list->word_offsets = NULL;
+	word_list->suffix_order = NULL;
+	word_list->suffix_word_lens = NULL;
+}
+
+RETURN_CODE WordList_CompilePattern (WordPattern *pattern, const char *string, size_t min_len, size_t max_len)
+{
+	unsigned long long state;
+	unsigned char class_chars[256];
+	int ch, first, last, not_in_class, literal;
+	size_t no_of_elements = 0, min_rest_len = 0, k;
+
+	memset(pattern, 0, sizeof(WordPattern));
+
+	for (; *string != '\0'; string++)
+	{
+		if ((*string == PATTERN_ANY_CHARS) && (no_of_elements > 0) && (pattern->any_chars_states & (1ULL << (no_of_elements - 1))))
+		{
+			/* "**" is "*" */
+			continue;
+		}
+
+		if (no_of_elements == PATTERN_MAX_ELEMENTS)
+		{
+			return RC_BAD_FORMAT;
+		}
+		state = 1ULL << no_of_elements++;
+
+		if (*string == PATTERN_ANY_CHARS)
+		{
+			pattern->any_chars_states |= state;
+			pattern->suffix_len = 0;
+			continue;
+		}
+
+		memset(class_chars, 0, sizeof(class_chars));
+		literal = (*string != PATTERN_ANY_CHAR) && (*string != PATTERN_CLASS_START);
+
+		if (*string == PATTERN_ANY_CHAR)
+		{
+			memset(class_chars, 1, sizeof(class_chars));
+		}
+		else if (*string == PATTERN_CLASS_START)
+		{
+			string++;
+			not_in_class = (*string == PATTERN_CLASS_NOT);
+			if (not_in_class)
+			{
+				string++;
+			}
+
+			/* a class end right after the class start is a class character (e.g. "[]a]") */
+			do
+			{
+				if (*string == '\0')
+				{
+					return RC_BAD_FORMAT;
+				}
+
+				first = last = (unsigned char)(*string);
+				if ((string[1] == PATTERN_CLASS_RANGE) && (string[2] != '\0') && (string[2] != PATTERN_CLASS_END))
+				{
+					last = (unsigned char)string[2];
+					string += 2;
+				}
+				for (ch = first; ch <= last; ch++)
+				{
+					class_chars[ch] = 1;
+				}
+				string++;
+			} while (*string != PATTERN_CLASS_END);
+
+			if (not_in_class)
+			{
+				for (ch = 0; ch < 256; ch++)
+				{
+					class_chars[ch] = !class_chars[ch];
+				}
+			}
+		}
+		else
+		{
+			class_chars[(unsigned char)(*string)] = 1;
+		}
+
+		/* only a run of plain characters at the end of pattern is its suffix */
+		if (literal)
+		{
+			pattern->suffix[pattern->suffix_len++] = *string;
+		}
+		else
+		{
+			pattern->suffix_len = 0;
+		}
+
+		for (ch = 1; ch < 256; ch++)
+		{
+			if (class_chars[ch])
+			{
+				pattern->char_states[ch] |= state;
+			}
+		}
+	}
+
+	pattern->end_state = 1ULL << no_of_elements;
+	pattern->start_states = patternClosure(pattern, 1);
+	pattern->min_len = min_len;
+	pattern->max_len = ((max_len == 0) || (max_len > MAX_WORD_LEN))? MAX_WORD_LEN: max_len;
+
+	/* from the end of pattern back: a state needs (at least) a character per one character element after it */
+	for (state = pattern->end_state; state != 0; state >>= 1)
+	{
+		for (k = min_rest_len; k <= MAX_WORD_LEN; k++)
+		{
+			pattern->fit_states[k] |= state;
+		}
+		if (!(pattern->any_chars_states & (state >> 1)))
+		{
+			min_rest_len++;
+		}
+	}
+
+	return RC_NO_ERROR;
+}
+
+int WordList_MatchPattern (WordPattern *pattern, const char *word)
+{
+	unsigned long long states = pattern->start_states;
+	size_t word_len;
+
+	for (word_len = 0; (word[word_len] != '\0') && (states != 0); word_len++)
+	{
+		states = patternStep(pattern, states, word[word_len]);
+	}
+
+	return (states & pattern->end_state) && (word_len >= pattern->min_len) && (word_len <= pattern->max_len);
+}
+
+size_t WordList_FindPattern (CharNode *char_tree, WordPattern *pattern, size_t max_results, void (*match_func) (char *word, unsigned int word_id))
+{
+	/* stack level k: next character node to try as word character k and the pattern states before it */
+	CharNode *level_nodes[MAX_WORD_LEN+1];
+	unsigned long long level_states[MAX_WORD_LEN+1];
+	char word[MAX_WORD_LEN+1];
+	unsigned long long states;
+	CharNode *char_node;
+	size_t no_of_matches = 0;
+	int level = 0;
+
+	level_nodes[0] = char_tree;
+	level_states[0] = pattern->start_states;
+
+	while (level >= 0)
+	{
+		char_node = level_nodes[level];
+		if (char_node == NULL)
+		{
+			/* all characters of this level tried */
+			level--;
+			continue;
+		}
+		level_nodes[level] = char_node->adjacent;
+
+		states = patternStep(pattern, level_states[level], char_node->ch) & pattern->fit_states[pattern->max_len - (level + 1)];
+		if (states == 0)
+		{
+			continue;
+		}
+
+		word[level] = char_node->ch;
+
+		if (char_node->is_word && (states & pattern->end_state) && ((size_t)(level + 1) >= pattern->min_len))
+		{
+			word[level+1] = '\0';
+			match_func(word, char_node->word_id);
+			if (++no_of_matches == max_results)
+			{
+				break;
+			}
+		}
+
+		/* go down if longer words may still match (some state before the end of pattern) */
+		if ((char_node->next != NULL) && ((size_t)(level + 1) < pattern->max_len) && (states & ~pattern->end_state))
+		{
+			level++;
+			level_nodes[level] = char_node->next;
+			level_states[level] = states;
+		}
+	}
+
+	return no_of_matches;
+}
+
+RETURN_CODE WordList_BuildSuffixOrder (WordList *word_list)
+{
+	SuffixKey *keys;
+	char *word;
+	size_t k;
+
+	free(word_list->suffix_order);
+	free(word_list->suffix_word_lens);
+	word_list->suffix_order = (unsigned int*)malloc((word_list->no_of_words + 1) * sizeof(unsigned int));
+	word_list->suffix_word_lens = (unsigned char*)malloc(word_list->no_of_words + 1);
+	keys = (SuffixKey*)malloc((word_list->no_of_words + 1) * sizeof(SuffixKey));
+	if ((word_list->suffix_order == NULL) || (word_list->suffix_word_lens == NULL) || (keys == NULL))
+	{
+		free(word_list->suffix_order);
+		free(word_list->suffix_word_lens);
+		free(keys);
+		word_list->suffix_order = NULL;
+		word_list->suffix_word_lens = NULL;
+		return RC_NO_MEM;
+	}
+
+	for (k = 0; k < word_list->no_of_words; k++)
+	{
+		word = WordList_GetWord(word_list, (unsigned int)k);
+		keys[k].key = suffixKey(word, strlen(word));
+		keys[k].word_id = (unsigned int)k;
+	}
+	qsort(keys, word_list->no_of_words, sizeof(SuffixKey), compareSuffixKeys);
+
+	for (k = 0; k < word_list->no_of_words; k++)
+	{
+		word_list->suffix_order[k] = keys[k].word_id;
+		word_list->suffix_word_lens[k] = (unsigned char)strlen(WordList_GetWord(word_list, keys[k].word_id));
+	}
+	free(keys);
+
+	return RC_NO_ERROR;
+}
+
+size_t WordList_FindPatternBySuffix (WordList *word_list, WordPattern *pattern, size_t max_results, void (*match_func) (char *word, unsigned int word_id))
+{
+	unsigned long long first_key, last_key;
+	size_t key_len, first, last, no_of_matches = 0;
+	char *word;
+
+	if ((word_list->suffix_order == NULL) || !(pattern->any_chars_states & 1) || (pattern->suffix_len == 0))
+	{
+		return WordList_FindPattern(word_list->char_tree, pattern, max_results, match_func);
+	}
+
+	/* the keys of the words that end with the (last SUFFIX_KEY_LEN characters of the) suffix: the suffix key with
+	   any bytes after it */
+	key_len = (pattern->suffix_len < SUFFIX_KEY_LEN)? pattern->suffix_len: SUFFIX_KEY_LEN;
+	first_key = suffixKey(pattern->suffix, pattern->suffix_len);
+	last_key = first_key | ((key_len < SUFFIX_KEY_LEN)? (~0ULL >> (8 * key_len)): 0);
+
+	first = findSuffixKey(word_list, first_key);
+	last = (last_key == ~0ULL)? word_list->no_of_words: findSuffixKey(word_list, last_key + 1);
+
+	for (; first < last; first++)
+	{
+		/* the word string is read only if the word length is within the bounds */
+		if ((word_list->suffix_word_lens[first] < pattern->min_len) || (word_list->suffix_word_lens[first] > pattern->max_len))
+		{
+			continue;
+		}
+
+		word = WordList_GetWord(word_list, word_list->suffix_order[first]);
+		if (WordList_MatchPattern(pattern, word))
+		{
+			match_func(word, word_list->suffix_order[first]);
+			if (++no_of_matches == max_results)
+			{
+				break;
+			}
+		}
+	}
+
+	return no_of_matches;
+}
+
+RETURN_CODE WordList_Relayout (WordList *word_list, const unsigned int *layout)
+{
+	size_t no_of_nodes = word_list->allocated_nodes;
+	CharNode **nodes, *src, *dst;
+	unsigned int *first_child;
+	size_t *offsets, arena_size = 0, k, m, index;
+	char *arena = NULL;
+	RETURN_CODE ret_code;
+
+	if (word_list->char_tree == NULL)
+	{
+		return RC_NO_ERROR;
+	}
+
+	ret_code = levelOrderNodes(word_list->char_tree, no_of_nodes, &nodes, &first_child);
+	if (ret_code != RC_NO_ERROR)
+	{
+		return ret_code;
+	}
+
+	/* arena offset of every node (by level order index) - each node is placed once */
+	offsets = (size_t*)malloc(no_of_nodes * sizeof(size_t));
+	if (offsets == NULL)
+	{
+		ret_code = RC_NO_MEM;
+	}
+	else
+	{
+		memset(offsets, 0xFF, no_of_nodes * sizeof(size_t));
+		for (k = 0; (k < no_of_nodes) && (ret_code == RC_NO_ERROR); k++)
+		{
+			index = (layout != NULL)? layout[k]: k;
+			if ((index >= no_of_nodes) || (offsets[index] != (size_t)~0))
+			{
+				ret_code = RC_BAD_FORMAT;
+			}
+			else
+			{
+				offsets[index] = arena_size;
+				arena_size += (nodes[index]->flags & NODE_WIDE)? sizeof(WideNode): sizeof(CharNode);
+			}
+		}
+	}
+
+	if (ret_code == RC_NO_ERROR)
+	{
+		arena = (char*)malloc(arena_size);
+		if (arena == NULL)
+		{
+			ret_code = RC_NO_MEM;
+		}
+	}
+
+	if (ret_code == RC_NO_ERROR)
+	{
+		for (index = 0; index < no_of_nodes; index++)
+		{
+			src = nodes[index];
+			dst = (CharNode*)(arena + offsets[index]);
+
+			if (src->flags & NODE_WIDE)
+			{
+				/* the character nodes of a wide node are its sibling list - consecutive in level order */
+				*(WideNode*)dst = *(WideNode*)src;
+				for (m = 0; (m < WIDE_NODE_MAX_CHARS) && (((WideNode*)src)->char_nodes[m] != NULL); m++)
+				{
+					((WideNode*)dst)->char_nodes[m] = (CharNode*)(arena + offsets[index + m]);
+				}
+			}
+			else
+			{
+				*dst = *src;
+			}
+
+			dst->flags |= NODE_ARENA;
+			dst->adjacent = (src->adjacent != NULL)? (CharNode*)(arena + offsets[index + 1]): NULL;
+			dst->next = (first_child[index] != NO_NODE_INDEX)? (CharNode*)(arena + offsets[first_child[index]]): NULL;
+		}
+
+		/* free the old nodes (and the old arena) */
+		WordList_FreeCharTree(word_list->char_tree);
+		free(word_list->node_arena);
+
+		word_list->char_tree = (CharNode*)(arena + offsets[0]);
+		word_list->node_arena = arena;
+		word_list->node_arena_size = arena_size;
+	}
+
+	free(nodes);
+	free(first_child);
+	free(offsets);
+
+	return ret_code;
+}
+
+RETURN_CODE WordList_InitProfile (WordListProfile *profile, WordList *word_list)
+{
+	RETURN_CODE ret_code;
+	size_t k;
+
+	memset(profile, 0, sizeof(WordListProfile));
+	if (word_list->char_tree == NULL)
+	{
+		return RC_NO_ERROR;
+	}
+
+	ret_code = levelOrderNodes(word_list->char_tree, word_list->allocated_nodes, &(profile->nodes), &(profile->first_child));
+	if (ret_code != RC_NO_ERROR)
+	{
+		return ret_code;
+	}
+	profile->no_of_nodes = word_list->allocated_nodes;
+
+	profile->counts = (unsigned int*)calloc(profile->no_of_nodes, sizeof(unsigned int));
+	profile->address_order = (unsigned int*)malloc(profile->no_of_nodes * sizeof(unsigned int));
+	if ((profile->counts == NULL) || (profile->address_order == NULL))
+	{
+		WordList_FreeProfile(profile);
+		return RC_NO_MEM;
+	}
+
+	for (k = 0; k < profile->no_of_nodes; k++)
+	{
+		profile->address_order[k] = (unsigned int)k;
+	}
+	sort_nodes = profile->nodes;
+	qsort(profile->address_order, profile->no_of_nodes, sizeof(unsigned int), compareNodeAddresses);
+
+	return RC_NO_ERROR;
+}
+
+void WordList_ProfileNode (WordListProfile *profile, CharNode *char_node)
+{
+	size_t low = 0, high = profile->no_of_nodes, middle;
+	CharNode *node;
+
+	while (low < high)
+	{
+		middle = low + ((high - low) / 2);
+		node = profile->nodes[profile->address_order[middle]];
+		if (node == char_node)
+		{
+			profile->counts[profile->address_order[middle]]++;
+			return;
+		}
+
+		if (node < char_node)
+		{
+			low = middle + 1;
+		}
+		else
+		{
+			high = middle;
+		}
+	}
+}
+
+RETURN_CODE WordList_ProfileLayout (WordListProfile *profile, unsigned int *layout)
+{
+	unsigned long long *keys, count;
+	size_t no_of_lists = 0, k, index, position = 0;
+
+	/* a key per sibling list: inverted access count of the list (high 32 bits) and level order index of its head */
+	keys = (unsigned long long*)malloc((profile->no_of_nodes + 1) * sizeof(unsigned long long));
+	if (keys == NULL)
+	{
+		return RC_NO_MEM;
+	}
+
+	for (k = 0; k < profile->no_of_nodes; k++)
+	{
+		/* list heads: the root list and the first child of every node */
+		if ((k != 0) && (profile->nodes[k - 1]->adjacent != NULL))
+		{
+			continue;
+		}
+
+		for (count = 0, index = k; ; index++)
+		{
+			count += profile->counts[index];
+			if (profile->nodes[index]->adjacent == NULL)
+			{
+				break;
+			}
+		}
+		if (count > 0xFFFFFFFFull)
+		{
+			count = 0xFFFFFFFFull;
+		}
+
+		keys[no_of_lists++] = ((0xFFFFFFFFull - count) << 32) | k;
+	}
+	qsort(keys, no_of_lists, sizeof(unsigned long long), compareListKeys);
+
+	for (k = 0; k < no_of_lists; k++)
+	{
+		for (index = (size_t)(keys[k] & 0xFFFFFFFFull); ; index++)
+		{
+			layout[position++] = (unsigned int)index;
+			if (profile->nodes[index]->adjacent == NULL)
+			{
+				break;
+			}
+		}
+	}
+	assert(position == profile->no_of_nodes);
+
+	free(keys);
+
+	return RC_NO_ERROR;
+}
+
+void WordList_FreeProfile (WordListProfile *profile)
+{
+	free(profile->nodes);
+	free(profile->first_child);
+	free(profile->counts);
+	free(profile->address_order);
+
+	memset(profile, 0, sizeof(WordListProfile));
+}
+
+RETURN_CODE WordList_SaveLayout (const unsigned int *layout, size_t no_of_nodes, FILE *file)
+{
+	unsigned int count = (unsigned int)no_of_nodes;
+
+	if ((fwrite(&count, sizeof(unsigned int), 1, file) != 1) || (fwrite(layout, sizeof(unsigned int), no_of_nodes, file) != no_of_nodes))
+	{
+		return RC_BAD_FORMAT;
+	}
+
+	return RC_NO_ERROR;
+}
+
+RETURN_CODE WordList_LoadLayout (unsigned int *layout, size_t no_of_nodes, FILE *file)
+{
+	unsigned int count;
+
+	if ((fread(&count, sizeof(unsigned int), 1, file) != 1) || (count != no_of_nodes) ||
+		(fread(layout, sizeof(unsigned int), no_of_nodes, file) != no_of_nodes))
+	{
+		return RC_BAD_FORMAT;
+	}
+
+	return RC_NO_ERROR;
+}
+
+void WordListOverlay_Init (WordListOverlay *overlay, WordList *base)
+{
+	memset(overlay, 0, sizeof(WordListOverlay));
+
+	overlay->base = base;
+	overlay->char_tree = base->char_tree;
+	overlay->no_of_words = base->no_of_words;
+}
+
+RETURN_CODE WordListOverlay_AddWord (WordListOverlay *overlay, char *word)
+{
+	CharNode *word_node;
+	RETURN_CODE ret_code;
+
+	if ((word[0] == '\0') || (strlen(word) > MAX_WORD_LEN))
+	{
+		return RC_BAD_FORMAT;
+	}
+
+	if ((overlay->char_tree != NULL) && (WordList_FindWord(overlay->char_tree, word) == WORD_FOUND))
+	{
+		return RC_NO_ERROR;
+	}
+
+	ret_code = copyOverlayPath(overlay, word, &word_node);
+	if (ret_code == RC_NO_ERROR)
+	{
+		ret_code = addWordToStringTable(&(overlay->added_words), word);
+	}
+	if (ret_code != RC_NO_ERROR)
+	{
+		return ret_code;
+	}
+
+	word_node->is_word = 1;
+	word_node->word_id = (unsigned int)(overlay->base->no_of_words + overlay->added_words.no_of_words);
+	overlay->added_words.no_of_words++;
+	overlay->no_of_words++;
+
+	return RC_NO_ERROR;
+}
+
+RETURN_CODE WordListOverlay_RemoveWord (WordListOverlay *overlay, char *word)
+{
+	CharNode *word_node;
+	RETURN_CODE ret_code;
+
+	if ((word[0] == '\0') || (overlay->char_tree == NULL) || (WordList_FindWord(overlay->char_tree, word) != WORD_FOUND))
+	{
+		return RC_NO_ERROR;
+	}
+
+	/* the word's nodes stay (as a prefix of no word, if no other word uses them) */
+	ret_code = copyOverlayPath(overlay, word, &word_node);
+	if (ret_code != RC_NO_ERROR)
+	{
+		return ret_code;
+	}
+
+	word_node->is_word = 0;
+	overlay->no_of_words--;
+	overlay->no_of_removed_words++;
+
+	return RC_NO_ERROR;
+}
+
+RETURN_CODE WordListOverlay_AddWords (WordListOverlay *overlay, FILE *file, int remove)
+{
+	LineReader *reader;
+	WordListLoadStats stats;
+	char word[MAX_WORD_LEN+1];
+	RETURN_CODE ret_code;
+
+	reader = (LineReader*)malloc(sizeof(LineReader));
+	if (reader == NULL)
+	{
+		return RC_NO_MEM;
+	}
+	initLineReader(reader, file);
+	memset(&stats, 0, sizeof(WordListLoadStats));
+
+	while ((ret_code = readNextWord(reader, 0, &stats, word)) == RC_NO_ERROR)
+	{
+		ret_code = remove? WordListOverlay_RemoveWord(overlay, word): WordListOverlay_AddWord(overlay, word);
+		if (ret_code != RC_NO_ERROR)
+		{
+			break;
+		}
+	}
+
+	free(reader);
+
+	return ret_code;
+}
+
+char* WordListOverlay_GetWord (WordListOverlay *overlay, unsigned int word_id)
+{
+	if (word_id < overlay->base->no_of_words)
+	{
+		return WordList_GetWord(overlay->base, word_id);
+	}
+
+	return WordList_GetWord(&(overlay->added_words), (unsigned int)(word_id - overlay->base->no_of_words));
+}
+
+void WordListOverlay_Free (WordListOverlay *overlay)
+{
+	size_t k;
+
+	for (k = 0; k < overlay->no_of_nodes; k++)
+	{
+		free(overlay->nodes[k]);
+	}
+	free(overlay->nodes);
+
+	WordList_Free(&(overlay->added_words));
+
+	overlay->nodes = NULL;
+	overlay->no_of_nodes = 0;
+	overlay->char_tree = overlay->base->char_tree;
 }
@@ -7,22 +7,69 @@
 #define WORD_FOUND		((int)1)
 #define PREFIX_FOUND	((int)2)
 
-#define READ_BUF_SIZE	256
-#define READ_BLOCK_LEN	100
+/* word list files are read in blocks - a longer line is an overlong word */
+#define READ_BLOCK_LEN	65536
 
 #define MAX_WORD_LEN	50
 
+#define NO_NODE_INDEX	((unsigned int)~0u)
+
+/* word list load flags (WordList_LoadCharTree) */
+#define LOAD_STRIP_CR			0x01	/* drop a CR at the end of a line (CRLF files) */
+#define LOAD_FOLD_CASE			0x02	/* 'A'..'Z' are read as 'a'..'z' */
+#define LOAD_STRIP_INVALID		0x04	/* drop characters other than 'a'..'z' from a word (e.g. "don't" -> "dont", "café" -> "caf") */
+#define LOAD_SKIP_INVALID		0x08	/* skip a word with characters other than 'a'..'z' (instead of LOAD_STRIP_INVALID) */
+#define LOAD_SKIP_OVERLONG		0x10	/* skip a word longer than MAX_WORD_LEN (instead of failing with RC_BAD_FORMAT) */
+#define LOAD_SORT				0x20	/* word IDs in sorted word order (instead of file order) */
+
+/* default load: words with other characters are skipped, not stripped (a stripped word is usually not a word) */
+#define LOAD_NORMALIZE			(LOAD_STRIP_CR | LOAD_FOLD_CASE | LOAD_SKIP_INVALID | LOAD_SKIP_OVERLONG)
+
+/* word pattern characters and limits */
+#define PATTERN_ANY_CHAR		'?'		/* any one character */
+#define PATTERN_ANY_CHARS		'*'		/* any (0 or more) characters */
+#define PATTERN_CLASS_START		'['		/* character class e.g. [aeiou], [a-f], [^xyz] */
+#define PATTERN_CLASS_END		']'
+#define PATTERN_CLASS_NOT		'^'
+#define PATTERN_CLASS_RANGE		'-'
+#define PATTERN_MAX_ELEMENTS	63		/* a state bit per element (and one for the end of pattern) */
+#define SUFFIX_KEY_LEN			8		/* last characters of a word in its suffix order key (one 64 bit key) */
+
+/* character node flags */
+#define NODE_OVERLAY	((unsigned char)0x01)	/* node belongs to a word list overlay (not to its base word list) */
+#define NODE_WIDE		((unsigned char)0x02)	/* node is the head of a wide node (a WideNode) */
+#define NODE_ARENA		((unsigned char)0x04)	/* node is in the word list node arena (not freed one by one) */
+
+/* wide node limits (number of characters of a sibling list stored as a wide node) */
+#define WIDE_NODE_MIN_CHARS		8
+#define WIDE_NODE_MAX_CHARS		32
+
 /* character node struct */
 typedef struct _CharNode 
 {
    char ch;
    unsigned char is_word;
+   unsigned char flags;
+   unsigned int word_id; /* dense word ID (index in the word list string table) - valid if is_word */
 
    struct _CharNode *adjacent;
    struct _CharNode *next;
 
 } CharNode;
 
+/* wide node struct - a sibling (ADJACENT) list of WIDE_NODE_MIN_CHARS..WIDE_NODE_MAX_CHARS character nodes whose
+   characters are also stored contiguously, so a character is found with one vector compare instead of a list walk */
+typedef struct _WideNode
+{
+	/* first character node of the sibling list (must be first - a wide node is linked and freed as this node) */
+	CharNode head;
+
+	/* sibling characters and nodes (in ADJACENT order, padded with 0 and NULL) */
+	char chars[WIDE_NODE_MAX_CHARS];
+	CharNode *char_nodes[WIDE_NODE_MAX_CHARS];
+
+} WideNode;
+
 /* word list struct */
 typedef struct _WordList
 {
@@ -32,9 +79,109 @@ typedef struct _WordList
 	size_t no_of_words;
 	size_t allocated_nodes;
 	size_t freed_nodes;
+	size_t wide_nodes;
+
+	/* character nodes (and wide nodes) in layout order after WordList_Relayout (or NULL) */
+	char *node_arena;
+	size_t node_arena_size;
+
+	/* string table: word ID k is the string at word_strings + word_offsets[k] */
+	char *word_strings;
+	size_t word_strings_len;
+	size_t allocated_word_strings;
+	unsigned int *word_offsets;
+	size_t allocated_word_offsets;
+
+	/* word IDs in the order of their reversed words (WordList_BuildSuffixOrder, or NULL) - the words that end with the
+	   same characters are consecutive - and their word lengths (in the same order) */
+	unsigned int *suffix_order;
+	unsigned char *suffix_word_lens;
 
 } WordList;
 
+/* word list overlay struct - a variant of a shared (immutable) base word list with words added and removed:
+   the overlay character tree holds copies of only the base nodes on the paths of the added/removed words (and of the
+   nodes before them in their sibling lists, whose links change) and shares all other base nodes, so its memory is
+   proportional to the delta and it is walked exactly as a word list */
+typedef struct _WordListOverlay
+{
+	/* base word list (never changed by the overlay) */
+	WordList *base;
+
+	/* overlay character tree */
+	CharNode *char_tree;
+
+	/* nodes owned by the overlay */
+	CharNode **nodes;
+	size_t no_of_nodes;
+	size_t allocated_nodes;
+
+	/* string table of added words (word ID base->no_of_words + k is added word k) */
+	WordList added_words;
+
+	size_t no_of_words;
+	size_t no_of_removed_words;
+
+} WordListOverlay;
+
+/* word list load statistics (WordList_LoadCharTree) */
+typedef struct _WordListLoadStats
+{
+	size_t lines;				/* lines read */
+	size_t words;				/* distinct words added */
+	size_t empty_lines;			/* empty lines (or lines of dropped characters only) skipped */
+	size_t duplicate_words;		/* words skipped as already added (after normalization) */
+	size_t folded_words;		/* words with upper case characters folded */
+	size_t stripped_words;		/* words with invalid characters dropped */
+	size_t invalid_words;		/* words with invalid characters skipped */
+	size_t overlong_words;		/* words longer than MAX_WORD_LEN skipped */
+
+} WordListLoadStats;
+
+/* word list profile struct - access count per character node of a word list, to lay its nodes out by (e.g.
+   WordsGrid_ProfileNodes over a sample of grids); nodes are numbered in level order (siblings are consecutive) */
+typedef struct _WordListProfile
+{
+	/* character nodes in level order and the level order index of each node's first child (or NO_NODE_INDEX) */
+	CharNode **nodes;
+	unsigned int *first_child;
+	size_t no_of_nodes;
+
+	/* access count per node */
+	unsigned int *counts;
+
+	/* level order indices sorted by node address (to find the index of a node) */
+	unsigned int *address_order;
+
+} WordListProfile;
+
+/* word pattern struct - a compiled pattern (e.g. "a?and?n", "ab*on", "[st]?[aeiou]*"): element k of the pattern is
+   state bit k, and a set of states is stepped by all its elements at once on each character */
+typedef struct _WordPattern
+{
+	/* elements (one character elements only) that match a character */
+	unsigned long long char_states[256];
+
+	/* PATTERN_ANY_CHARS elements */
+	unsigned long long any_chars_states;
+
+	/* states before the first character and at the end of pattern (word matched) */
+	unsigned long long start_states;
+	unsigned long long end_state;
+
+	/* states that may reach the end of pattern within k more characters (to stop at max_len) */
+	unsigned long long fit_states[MAX_WORD_LEN+1];
+
+	/* word length bounds */
+	size_t min_len;
+	size_t max_len;
+
+	/* characters at the end of pattern that match only themselves (e.g. "ing" of "*ing") */
+	char suffix[PATTERN_MAX_ELEMENTS+1];
+	size_t suffix_len;
+
+} WordPattern;
+
 /***********************************************************************************************************************
  *                                                                                                                     *
  * FUNCTION: WordList_BuildCharTree                                                                                    *
@@ -49,11 +196,35 @@ typedef struct _WordList
  *            RC_NO_MEM - no memory                                                                                    *
  *            RC_EOF - no error (end of file)                                                                          *
  *                                                                                                                     *
- * NOTES:                                                                                                              *
+ * NOTES: every word gets a dense word ID (0, 1, 2, ... in file order) kept in its terminal character node and in      *
+ *        the word list string table                                                                                   *
  *                                                                                                                     *
  ***********************************************************************************************************************/
 RETURN_CODE WordList_BuildCharTree (WordList *word_list, FILE *file);
 
+/***********************************************************************************************************************
+ *                                                                                                                     *
+ * FUNCTION: WordList_LoadCharTree                                                                                     *
+ *                                                                                                                     *
+ * DESCRIPTION: build character tree for word list from a (raw) word list input file - every line is normalized by     *
+ *              load flags on its way from the read buffer to the character tree                                       *
+ *                                                                                                                     *
+ * PARAMETERS: word_list (in/out) - pointer to word list to build its character tree                                   *
+ *             file (in) - pointer to (already open) input file to read word list from (<word><LF>...)                 *
+ *             load_flags (in) - LOAD_xxx flags (e.g. LOAD_NORMALIZE, LOAD_NORMALIZE | LOAD_SORT; 0 is                 *
+ *                               WordList_BuildCharTree)                                                               *
+ *             stats (out) - pointer to load statistics (or NULL)                                                      *
+ *                                                                                                                     *
+ * RETURN: RC_BAD_FORMAT - file format error (a word longer than MAX_WORD_LEN with no LOAD_SKIP_OVERLONG)              *
+ *         RC_NO_MEM - no memory                                                                                       *
+ *         RC_EOF - no error (end of file)                                                                             *
+ *                                                                                                                     *
+ * NOTES: duplicated words (e.g. "Don't" and "dont" normalized) are added once - no pre-cleaned file is needed         *
+ *        a line is normalized in place, 16 characters at a time (SSE2) where available                                *
+ *                                                                                                                     *
+ ***********************************************************************************************************************/
+RETURN_CODE WordList_LoadCharTree (WordList *word_list, FILE *file, unsigned int load_flags, WordListLoadStats *stats);
+
 /***********************************************************************************************************************
  *                                                                                                                     *
  * FUNCTION: WordList_FindWord                                                                                         *
@@ -72,6 +243,39 @@ RETURN_CODE WordList_BuildCharTree (WordList *word_list, FILE *file);
  ***********************************************************************************************************************/
 int WordList_FindWord (CharNode *char_tree, char *word);
 
+/***********************************************************************************************************************
+ *                                                                                                                     *
+ * FUNCTION: WordList_FindChar                                                                                         *
+ *                                                                                                                     *
+ * DESCRIPTION: search a character in one level (ADJACENT list) of a word list's character tree                        *
+ *              (one step of a character-by-character walk down the character tree)                                    *
+ *                                                                                                                     *
+ * PARAMETERS: char_tree (in) - pointer to the first character node of a character tree level                          *
+ *             ch (in) - character to search                                                                           *
+ *                                                                                                                     *
+ * RETURN: pointer to the character node of ch (or NULL if ch is not found in this level)                              *
+ *                                                                                                                     *
+ * NOTES: the next level to search is the NEXT pointer of the returned character node                                  *
+ *                                                                                                                     *
+ ***********************************************************************************************************************/
+CharNode* WordList_FindChar (CharNode *char_tree, char ch);
+
+/***********************************************************************************************************************
+ *                                                                                                                     *
+ * FUNCTION: WordList_GetWord                                                                                          *
+ *                                                                                                                     *
+ * DESCRIPTION: get the string of a word ID from the word list string table                                            *
+ *                                                                                                                     *
+ * PARAMETERS: word_list (in) - pointer to word list                                                                   *
+ *             word_id (in) - word ID (word_id of a word's terminal character node)                                    *
+ *                                                                                                                     *
+ * RETURN: pointer to the word string (in the string table - must not be changed)                                      *
+ *                                                                                                                     *
+ * NOTES:                                                                                                              *
+ *                                                                                                                     *
+ ***********************************************************************************************************************/
+char* WordList_GetWord (WordList *word_list, unsigned int word_id);
+
 /***********************************************************************************************************************
  *                                                                                                                     *
  * FUNCTION: WordList_FreeCharTree                                                                                     *
@@ -87,4 +291,342 @@ int WordList_FindWord (CharNode *char_tree, char *word);
  ***********************************************************************************************************************/
 size_t WordList_FreeCharTree (CharNode *char_tree);
 
+/***********************************************************************************************************************
+ *                                                                                                                     *
+ * FUNCTION: WordList_Free                                                                                             *
+ *                                                                                                                     *
+ * DESCRIPTION: free memory dynamically allocated for word list (character tree and string table)                      *
+ *                                                                                                                     *
+ * PARAMETERS: word_list (in/out) - pointer to word list                                                               *
+ *                                                                                                                     *
+ * RETURN: none                                                                                                        *
+ *                                                                                                                     *
+ * NOTES: must be called to free memory at the end of word list life time (sets freed_nodes)                           *
+ *                                                                                                                     *
+ ***********************************************************************************************************************/
+void WordList_Free (WordList *word_list);
+
+/***********************************************************************************************************************
+ *                                                                                                                     *
+ * FUNCTION: WordList_CompilePattern                                                                                   *
+ *                                                                                                                     *
+ * DESCRIPTION: compile a word pattern of characters, PATTERN_ANY_CHAR, PATTERN_ANY_CHARS and character classes        *
+ *                                                                                                                     *
+ * PARAMETERS: pattern (out) - pointer to word pattern                                                                 *
+ *             string (in) - pattern string e.g. "a?and?n", "ab*on", "[a-c]*[^s]"                                      *
+ *             min_len, max_len (in) - word length bounds (max_len 0 for MAX_WORD_LEN)                                 *
+ *                                                                                                                     *
+ * RETURN: RC_NO_ERROR - no error                                                                                      *
+ *         RC_BAD_FORMAT - bad pattern (a class with no end or more than PATTERN_MAX_ELEMENTS elements)                *
+ *                                                                                                                     *
+ * NOTES:                                                                                                              *
+ *                                                                                                                     *
+ ***********************************************************************************************************************/
+RETURN_CODE WordList_CompilePattern (WordPattern *pattern, const char *string, size_t min_len, size_t max_len);
+
+/***********************************************************************************************************************
+ *                                                                                                                     *
+ * FUNCTION: WordList_MatchPattern                                                                                     *
+ *                                                                                                                     *
+ * DESCRIPTION: does a word match a word pattern                                                                       *
+ *                                                                                                                     *
+ * PARAMETERS: pattern (in) - pointer to (compiled) word pattern                                                       *
+ *             word (in) - word                                                                                        *
+ *                                                                                                                     *
+ * RETURN: 1 - match, 0 - no match                                                                                     *
+ *                                                                                                                     *
+ * NOTES:                                                                                                              *
+ *                                                                                                                     *
+ ***********************************************************************************************************************/
+int WordList_MatchPattern (WordPattern *pattern, const char *word);
+
+/***********************************************************************************************************************
+ *                                                                                                                     *
+ * FUNCTION: WordList_FindPattern                                                                                      *
+ *                                                                                                                     *
+ * DESCRIPTION: find all words of a character tree that match a word pattern                                           *
+ *                                                                                                                     *
+ * PARAMETERS: char_tree (in) - pointer to character tree (of a word list or of a word list overlay)                   *
+ *             pattern (in) - pointer to (compiled) word pattern                                                       *
+ *             max_results (in) - maximal number of matches to find (0 for all)                                        *
+ *             match_func (in) - pointer to function called with each matching word (in character tree order)          *
+ *                               and its word ID                                                                       *
+ *                                                                                                                     *
+ * RETURN: number of matches                                                                                           *
+ *                                                                                                                     *
+ * NOTES: the character tree is walked with an explicit stack (a level per word character), branching only on          *
+ *        characters some pattern state still matches and stopping at max_len                                          *
+ *        a pattern that starts with PATTERN_ANY_CHARS visits every word prefix up to max_len characters (its cost is  *
+ *        bound by the word list, not by its matches) - see WordList_FindPatternBySuffix                               *
+ *                                                                                                                     *
+ ***********************************************************************************************************************/
+size_t WordList_FindPattern (CharNode *char_tree, WordPattern *pattern, size_t max_results, void (*match_func) (char *word, unsigned int word_id));
+
+/***********************************************************************************************************************
+ *                                                                                                                     *
+ * FUNCTION: WordList_BuildSuffixOrder                                                                                 *
+ *                                                                                                                     *
+ * DESCRIPTION: sort the word IDs of a word list by their reversed words (for WordList_FindPatternBySuffix)            *
+ *                                                                                                                     *
+ * PARAMETERS: word_list (in/out) - pointer to word list                                                               *
+ *                                                                                                                     *
+ * RETURN: RC_NO_ERROR - no error                                                                                      *
+ *         RC_NO_MEM - no memory                                                                                       *
+ *                                                                                                                     *
+ * NOTES: words are sorted by their last SUFFIX_KEY_LEN characters only; a word ID and a length per word (5 bytes a    *
+ *        word)                                                                                                        *
+ *                                                                                                                     *
+ ***********************************************************************************************************************/
+RETURN_CODE WordList_BuildSuffixOrder (WordList *word_list);
+
+/***********************************************************************************************************************
+ *                                                                                                                     *
+ * FUNCTION: WordList_FindPatternBySuffix                                                                              *
+ *                                                                                                                     *
+ * DESCRIPTION: find all words of a word list that match a word pattern that starts with PATTERN_ANY_CHARS - only      *
+ *              the words that end with the pattern suffix are matched (e.g. the words ending with "ing" for "*ing")   *
+ *                                                                                                                     *
+ * PARAMETERS: word_list (in) - pointer to word list (with a suffix order)                                             *
+ *             pattern (in) - pointer to (compiled) word pattern                                                       *
+ *             max_results (in) - maximal number of matches to find (0 for all)                                        *
+ *             match_func (in) - pointer to function called with each matching word (in suffix order) and its word ID  *
+ *                                                                                                                     *
+ * RETURN: number of matches                                                                                           *
+ *                                                                                                                     *
+ * NOTES: the words ending with the pattern suffix are a range of the suffix order (found by binary search), and only  *
+ *        its words of a length within the pattern bounds are matched; with no suffix order, or a pattern that does    *
+ *        not start with PATTERN_ANY_CHARS or has no suffix, finds by WordList_FindPattern (in character tree order),  *
+ *        which prunes by the pattern prefix                                                                           *
+ *                                                                                                                     *
+ ***********************************************************************************************************************/
+size_t WordList_FindPatternBySuffix (WordList *word_list, WordPattern *pattern, size_t max_results, void (*match_func) (char *word, unsigned int word_id));
+
+/***********************************************************************************************************************
+ *                                                                                                                     *
+ * FUNCTION: WordList_Relayout                                                                                         *
+ *                                                                                                                     *
+ * DESCRIPTION: copy the character tree of a word list into one contiguous node arena in a given node order            *
+ *                                                                                                                     *
+ * PARAMETERS: word_list (in/out) - pointer to (built) word list                                                       *
+ *             layout (in) - level order index of the node at each arena position - allocated_nodes indices            *
+ *                           (e.g. by WordList_ProfileLayout or WordList_LoadLayout), or NULL for level order          *
+ *                                                                                                                     *
+ * RETURN: RC_NO_ERROR - no error                                                                                      *
+ *         RC_BAD_FORMAT - layout is not an order of all nodes                                                         *
+ *         RC_NO_MEM - no memory (the character tree is not changed)                                                   *
+ *                                                                                                                     *
+ * NOTES: all character node pointers into the word list (overlays, profiles, words grid results) become invalid -     *
+ *        relayout first, then create them; in level order every sibling list is consecutive                           *
+ *                                                                                                                     *
+ ***********************************************************************************************************************/
+RETURN_CODE WordList_Relayout (WordList *word_list, const unsigned int *layout);
+
+/***********************************************************************************************************************
+ *                                                                                                                     *
+ * FUNCTION: WordList_InitProfile                                                                                      *
+ *                                                                                                                     *
+ * DESCRIPTION: initialise an (all counts 0) node access profile of a word list                                        *
+ *                                                                                                                     *
+ * PARAMETERS: profile (out) - pointer to word list profile                                                            *
+ *             word_list (in) - pointer to (built) word list                                                           *
+ *                                                                                                                     *
+ * RETURN: RC_NO_ERROR - no error                                                                                      *
+ *         RC_NO_MEM - no memory                                                                                       *
+ *                                                                                                                     *
+ * NOTES:                                                                                                              *
+ *                                                                                                                     *
+ ***********************************************************************************************************************/
+RETURN_CODE WordList_InitProfile (WordListProfile *profile, WordList *word_list);
+
+/***********************************************************************************************************************
+ *                                                                                                                     *
+ * FUNCTION: WordList_ProfileNode                                                                                      *
+ *                                                                                                                     *
+ * DESCRIPTION: count an access to a character node in a word list profile                                             *
+ *                                                                                                                     *
+ * PARAMETERS: profile (in/out) - pointer to word list profile                                                         *
+ *             char_node (in) - pointer to character node (a node not of the profiled word list is ignored)            *
+ *                                                                                                                     *
+ * RETURN: none                                                                                                        *
+ *                                                                                                                     *
+ * NOTES: finds the node by binary search (for profiling runs, not for the grid search)                                *
+ *                                                                                                                     *
+ ***********************************************************************************************************************/
+void WordList_ProfileNode (WordListProfile *profile, CharNode *char_node);
+
+/***********************************************************************************************************************
+ *                                                                                                                     *
+ * FUNCTION: WordList_ProfileLayout                                                                                    *
+ *                                                                                                                     *
+ * DESCRIPTION: node layout by access frequency: sibling lists are kept together and ordered by their access count     *
+ *              (most accessed first), so the nodes a search visits together share cache lines and the hot lists are   *
+ *              packed at the start of the arena                                                                       *
+ *                                                                                                                     *
+ * PARAMETERS: profile (in) - pointer to word list profile                                                             *
+ *             layout (out) - level order index of the node at each position (profile->no_of_nodes indices)            *
+ *                                                                                                                     *
+ * RETURN: RC_NO_ERROR - no error                                                                                      *
+ *         RC_NO_MEM - no memory                                                                                       *
+ *                                                                                                                     *
+ * NOTES: lists with equal counts (e.g. never accessed) are kept in level order                                        *
+ *                                                                                                                     *
+ ***********************************************************************************************************************/
+RETURN_CODE WordList_ProfileLayout (WordListProfile *profile, unsigned int *layout);
+
+/***********************************************************************************************************************
+ *                                                                                                                     *
+ * FUNCTION: WordList_FreeProfile                                                                                      *
+ *                                                                                                                     *
+ * DESCRIPTION: free memory dynamically allocated for word list profile                                                *
+ *                                                                                                                     *
+ * PARAMETERS: profile (in/out) - pointer to word list profile                                                         *
+ *                                                                                                                     *
+ * RETURN: none                                                                                                        *
+ *                                                                                                                     *
+ * NOTES:                                                                                                              *
+ *                                                                                                                     *
+ ***********************************************************************************************************************/
+void WordList_FreeProfile (WordListProfile *profile);
+
+/***********************************************************************************************************************
+ *                                                                                                                     *
+ * FUNCTION: WordList_SaveLayout                                                                                       *
+ *                                                                                                                     *
+ * DESCRIPTION: save a node layout to a file (to relayout the same word list later with no profiling run)              *
+ *                                                                                                                     *
+ * PARAMETERS: layout (in) - node layout                                                                               *
+ *             no_of_nodes (in) - number of nodes                                                                      *
+ *             file (in) - pointer to (already open, binary) output file                                               *
+ *                                                                                                                     *
+ * RETURN: RC_NO_ERROR - no error                                                                                      *
+ *         RC_BAD_FORMAT - file write error                                                                            *
+ *                                                                                                                     *
+ * NOTES: file format: number of nodes and the layout (unsigned int each)                                              *
+ *                                                                                                                     *
+ ***********************************************************************************************************************/
+RETURN_CODE WordList_SaveLayout (const unsigned int *layout, size_t no_of_nodes, FILE *file);
+
+/***********************************************************************************************************************
+ *                                                                                                                     *
+ * FUNCTION: WordList_LoadLayout                                                                                       *
+ *                                                                                                                     *
+ * DESCRIPTION: load a node layout saved by WordList_SaveLayout                                                        *
+ *                                                                                                                     *
+ * PARAMETERS: layout (out) - node layout (no_of_nodes indices)                                                        *
+ *             no_of_nodes (in) - number of nodes of the word list to relayout (allocated_nodes)                       *
+ *             file (in) - pointer to (already open, binary) input file                                                *
+ *                                                                                                                     *
+ * RETURN: RC_NO_ERROR - no error                                                                                      *
+ *         RC_BAD_FORMAT - file format error (e.g. a layout of another word list)                                      *
+ *                                                                                                                     *
+ * NOTES:                                                                                                              *
+ *                                                                                                                     *
+ ***********************************************************************************************************************/
+RETURN_CODE WordList_LoadLayout (unsigned int *layout, size_t no_of_nodes, FILE *file);
+
+/***********************************************************************************************************************
+ *                                                                                                                     *
+ * FUNCTION: WordListOverlay_Init                                                                                      *
+ *                                                                                                                     *
+ * DESCRIPTION: initialise an (empty) word list overlay of a base word list                                            *
+ *                                                                                                                     *
+ * PARAMETERS: overlay (out) - pointer to word list overlay                                                            *
+ *             base (in) - pointer to (built) base word list                                                           *
+ *                                                                                                                     *
+ * RETURN: none                                                                                                        *
+ *                                                                                                                     *
+ * NOTES: the base word list must not be changed or freed during the overlay life time                                 *
+ *                                                                                                                     *
+ ***********************************************************************************************************************/
+void WordListOverlay_Init (WordListOverlay *overlay, WordList *base);
+
+/***********************************************************************************************************************
+ *                                                                                                                     *
+ * FUNCTION: WordListOverlay_AddWord                                                                                   *
+ *                                                                                                                     *
+ * DESCRIPTION: add a word to a word list overlay                                                                      *
+ *                                                                                                                     *
+ * PARAMETERS: overlay (in/out) - pointer to word list overlay                                                         *
+ *             word (in) - word to be added                                                                            *
+ *                                                                                                                     *
+ * RETURN: RC_NO_ERROR - no error (also if the word is already in the overlay)                                         *
+ *         RC_BAD_FORMAT - word is empty or too long                                                                   *
+ *         RC_NO_MEM - no memory                                                                                       *
+ *                                                                                                                     *
+ * NOTES: an added word gets word ID base->no_of_words + (number of words added before it)                             *
+ *        a changed word costs the overlay copies of the base nodes on its path and before them in their sibling       *
+ *        lists that the overlay does not own yet (on word.list: ~34 nodes, 1 KB, for one word; ~8.5 nodes a word      *
+ *        over 10000 words spread over the word list, as the upper sibling lists are copied once)                      *
+ *                                                                                                                     *
+ ***********************************************************************************************************************/
+RETURN_CODE WordListOverlay_AddWord (WordListOverlay *overlay, char *word);
+
+/***********************************************************************************************************************
+ *                                                                                                                     *
+ * FUNCTION: WordListOverlay_RemoveWord                                                                                *
+ *                                                                                                                     *
+ * DESCRIPTION: remove a word from a word list overlay                                                                 *
+ *                                                                                                                     *
+ * PARAMETERS: overlay (in/out) - pointer to word list overlay                                                         *
+ *             word (in) - word to be removed                                                                          *
+ *                                                                                                                     *
+ * RETURN: RC_NO_ERROR - no error (also if the word is not in the overlay)                                             *
+ *         RC_NO_MEM - no memory                                                                                       *
+ *                                                                                                                     *
+ * NOTES: costs overlay nodes as WordListOverlay_AddWord                                                               *
+ *                                                                                                                     *
+ ***********************************************************************************************************************/
+RETURN_CODE WordListOverlay_RemoveWord (WordListOverlay *overlay, char *word);
+
+/***********************************************************************************************************************
+ *                                                                                                                     *
+ * FUNCTION: WordListOverlay_AddWords                                                                                  *
+ *                                                                                                                     *
+ * DESCRIPTION: add (or remove) all words of a word list input file to (from) a word list overlay                      *
+ *                                                                                                                     *
+ * PARAMETERS: overlay (in/out) - pointer to word list overlay                                                         *
+ *             file - (in) pointer to (already open) input file to read words from                                     *
+ *                          convernsion: <word><LF><word><LF><word><LF>...                                             *
+ *             remove - (in) yes/no remove the words (instead of adding them)                                          *
+ *                                                                                                                     *
+ * RETURN:    RC_BAD_FORMAT - file format error                                                                        *
+ *            RC_NO_MEM - no memory                                                                                    *
+ *            RC_EOF - no error (end of file)                                                                          *
+ *                                                                                                                     *
+ * NOTES:                                                                                                              *
+ *                                                                                                                     *
+ ***********************************************************************************************************************/
+RETURN_CODE WordListOverlay_AddWords (WordListOverlay *overlay, FILE *file, int remove);
+
+/***********************************************************************************************************************
+ *                                                                                                                     *
+ * FUNCTION: WordListOverlay_GetWord                                                                                   *
+ *                                                                                                                     *
+ * DESCRIPTION: get the string of a word ID of a word list overlay (base word or added word)                           *
+ *                                                                                                                     *
+ * PARAMETERS: overlay (in) - pointer to word list overlay                                                             *
+ *             word_id (in) - word ID (word_id of a word's terminal character node in the overlay character tree)      *
+ *                                                                                                                     *
+ * RETURN: pointer to the word string (must not be changed)                                                            *
+ *                                                                                                                     *
+ * NOTES:                                                                                                              *
+ *                                                                                                                     *
+ ***********************************************************************************************************************/
+char* WordListOverlay_GetWord (WordListOverlay *overlay, unsigned int word_id);
+
+/***********************************************************************************************************************
+ *                                                                                                                     *
+ * FUNCTION: WordListOverlay_Free                                                                                      *
+ *                                                                                                                     *
+ * DESCRIPTION: free memory dynamically allocated for word list overlay (its base word list is not freed)              *
+ *                                                                                                                     *
+ * PARAMETERS: overlay (in/out) - pointer to word list overlay                                                         *
+ *                                                                                                                     *
+ * RETURN: none                                                                                                        *
+ *                                                                                                                     *
+ * NOTES:                                                                                                              *
+ *                                                                                                                     *
+ ***********************************************************************************************************************/
+void WordListOverlay_Free (WordListOverlay *overlay);
+
 #endif // _WORD_LIST_H_
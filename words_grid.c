@@ -1,19 +1,151 @@
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 #include <assert.h>
+#include <stdatomic.h>
+
+#ifndef WORDS_GRID_NO_THREADS
+#include <pthread.h>
+#endif
 
 #include "gen_defs.h"
 #include "word_list.h"
 
 #include "words_grid.h"
+#include "grid_cache.h"
+#include "rack_index.h"
+
+/* minimal size of the found words per word hash table */
+#define WORD_COUNTS_MIN_SIZE	64
+
+/* search task of a parallel search - a start path (start cell and up to SEARCH_TASK_STEPS steps) */
+typedef struct _SearchTask
+{
+	CellIndex path[SEARCH_TASK_STEPS+1];
+	int path_len;
+
+	/* character node of the last path character */
+	CharNode *char_node;
+
+	/* 1 - the path and all its extensions, 0 - the path only (its extensions are tasks of their own) */
+	int subtree;
+
+	/* found word IDs of the task - in the word IDs of the worker that ran it */
+	int worker;
+	size_t first_word;
+	size_t no_of_words;
+
+} SearchTask;
+
+/* search worker of a parallel search - a thread, its range of tasks and its found words */
+typedef struct _SearchWorker
+{
+	struct _ParallelSearch *parallel;
+	int index;
+
+	/* tasks not run yet: first (low 32 bits) .. last-1 (high 32 bits) - the worker takes its tasks from the first
+	   end, other workers steal from the last end */
+	_Atomic unsigned long long task_range;
+
+	/* found word IDs of the tasks run by the worker (in task run order) */
+	unsigned int *word_ids;
+	size_t no_of_word_ids;
+	size_t allocated_word_ids;
+
+	RETURN_CODE ret_code;
+
+} SearchWorker;
+
+/* parallel search (WordsGrid_OutputFoundWordsParallel) */
+typedef struct _ParallelSearch
+{
+	WordsGrid *words_grid;
+
+	/* tasks in the order of the serial search */
+	SearchTask *tasks;
+	size_t no_of_tasks;
+	size_t allocated_tasks;
+
+	SearchWorker workers[MAX_SEARCH_THREADS];
+	int no_of_workers;
+
+} ParallelSearch;
+
+/* search order key of a found path (start cell and the direction of every step) - the search finds paths in the
+   order of their keys (a path before its extensions) */
+typedef struct _SearchOrderKey
+{
+	unsigned char key[MAX_PATH_LEN+1];
+
+	/* path index and its first cell in a grid cache entry */
+	unsigned int path;
+	unsigned int offset;
+
+} SearchOrderKey;
+
+/* path search state (WordsGrid_Solve, WordsGrid_SetCell, cached and parallel WordsGrid_OutputFoundWords) */
+typedef struct _PathSearch
+{
+	/* function called for every found path (the current path) */
+	RETURN_CODE (*found_func) (WordsGrid *words_grid, struct _PathSearch *search, CharNode *char_node);
+
+	/* grid control and the path of the current prefix */
+	char grid_ctrl[GRID_X_LEN][GRID_Y_LEN];
+	CellIndex path[MAX_PATH_LEN];
+	int path_len;
+
+	/* delta to count gained words to (or NULL) */
+	WordsGridDelta *delta;
+
+	/* symmetry that maps grid to its canonical grid and the grid cache entry builder to add paths to (or NULL) */
+	int symmetry;
+	GridCacheBuilder *builder;
+
+	/* parallel search worker to collect found words to (or NULL) */
+	SearchWorker *worker;
+
+	RETURN_CODE ret_code;
+
+} PathSearch;
 
 /*******************************************************************************************************************************************************/
 /************************************************************ internal functions declation *************************************************************/
 /*******************************************************************************************************************************************************/
 static void initGridCtrl (char grid_ctrl[][GRID_Y_LEN], int size);
-static void gridCopy (char grid_dest[][GRID_Y_LEN], char grid_src[][GRID_Y_LEN], int size);
-static void outputFoundWordsFromPrefix (WordsGrid *words_grid, char *word, int i, int j, char grid_ctrl[][GRID_Y_LEN], int size);
+static CharNode* gridCharTree (WordsGrid *words_grid);
+static char* gridWord (WordsGrid *words_grid, unsigned int word_id);
+static void outputWord (WordsGrid *words_grid, unsigned int word_id);
+static void outputFoundWordsFromPrefix (WordsGrid *words_grid, CharNode *char_node, int i, int j, char grid_ctrl[][GRID_Y_LEN], int size, int word_len);
 static int getNextAdjacentUnusedCell (char grid_ctrl[][GRID_Y_LEN], int size, int i, int j, int *x, int *y);
+static int isRulesWord (WordsGrid *words_grid, CharNode *char_node, int word_len);
+static void initResultSet (ResultSet *result_set);
+static void clearResultSet (ResultSet *result_set);
+static void freeResultSet (ResultSet *result_set);
+static RETURN_CODE growWordCounts (ResultSet *result_set);
+static WordCount* findWordCount (ResultSet *result_set, CharNode *word_node, int add);
+static int pathUsesCell (FoundPath *found_path, CellIndex cell);
+static RETURN_CODE addFoundPath (WordsGrid *words_grid, CharNode *char_node, CellIndex *path, int path_len, WordsGridDelta *delta);
+static RETURN_CODE addLostWord (ResultSet *result_set, FoundPath *found_path);
+static RETURN_CODE addSearchPath (WordsGrid *words_grid, PathSearch *search, CharNode *char_node);
+static RETURN_CODE outputSearchPath (WordsGrid *words_grid, PathSearch *search, CharNode *char_node);
+static void searchPathsFromNode (WordsGrid *words_grid, PathSearch *search, CharNode *char_node, int i, int j);
+static RETURN_CODE searchAllPaths (WordsGrid *words_grid, PathSearch *search);
+static void searchOrderKey (CellIndex *path, int path_len, unsigned char *key);
+static int compareSearchOrderKeys (const void *key1, const void *key2);
+static void outputCachedWords (WordsGrid *words_grid, GridCacheEntry *entry);
+static RETURN_CODE searchPathsThroughCell (WordsGrid *words_grid, int x, int y, WordsGridDelta *delta);
+static int findWordFromCell (WordsGrid *words_grid, char *word, int i, int j, char grid_ctrl[][GRID_Y_LEN], CellIndex *path, int path_len);
+static int findWordPath (WordsGrid *words_grid, char *word, CellIndex *path);
+static unsigned int gridLetterMask (WordsGrid *words_grid);
+static void setCanonicalGrid (WordsGrid *words_grid);
+static RETURN_CODE addSearchTask (ParallelSearch *parallel, PathSearch *search, CharNode *char_node, int subtree);
+static RETURN_CODE splitSearchFromNode (ParallelSearch *parallel, PathSearch *search, CharNode *char_node, int i, int j);
+static RETURN_CODE collectSearchPath (WordsGrid *words_grid, PathSearch *search, CharNode *char_node);
+static long claimSearchTask (SearchWorker *worker);
+static void runSearchTask (SearchWorker *worker, PathSearch *search, SearchTask *task);
+static void* searchWorkerThread (void *worker);
+static RETURN_CODE growGameResult (GameResult *game_result, unsigned int word_id, size_t no_of_cells);
+static RETURN_CODE addGameWord (WordsGrid *words_grid, PathSearch *search, CharNode *char_node);
 
 /*******************************************************************************************************************************************************/
 /************************************************************ internal functions definition ************************************************************/
@@ -44,29 +176,71 @@ static void initGridCtrl (char grid_ctrl[][GRID_Y_LEN], int size)
 	}
 }
 
-/**********************************************************************************************************************
- * FUNCTION: gridCopy                                                                                                 *
- *                                                                                                                    *
- * DESCRIPTION: copy one grid to another                                                                              *
- *                                                                                                                    *
- * PARAMETERS: (out) grid_dest - destination grid                                                                     *
- *             (in)  grid_src - source grid                                                                           *
- *                                                                                                                    *
- * RETURN: none                                                                                                       *
- *                                                                                                                    *
- * NOTES:                                                                                                             *
- *                                                                                                                    *
- *********************************************************************************************************************/
-static void gridCopy (char grid_dest[][GRID_Y_LEN], char grid_src[][GRID_Y_LEN], int size)
+/***********************************************************************************************************************
+ *                                                                                                                     *
+ * FUNCTION: gridCharTree                                                                                              *
+ *                                                                                                                     *
+ * DESCRIPTION: get the character tree searched by words grid (of its overlay if set, otherwise of its word list)      *
+ *                                                                                                                     *
+ * PARAMETERS: words_grid - (in) pointer to words grid                                                                 *
+ *                                                                                                                     *
+ * RETURN: pointer to character tree                                                                                   *
+ *                                                                                                                     *
+ * NOTES:                                                                                                              *
+ *                                                                                                                     *
+ ***********************************************************************************************************************/
+static CharNode* gridCharTree (WordsGrid *words_grid)
 {
-	int i, j;
-   
-	for (i = 0; i < size; i++)
+	return (words_grid->overlay != NULL)? words_grid->overlay->char_tree: words_grid->word_list.char_tree;
+}
+
+/***********************************************************************************************************************
+ *                                                                                                                     *
+ * FUNCTION: gridWord                                                                                                  *
+ *                                                                                                                     *
+ * DESCRIPTION: get the string of a word ID of the character tree searched by words grid                               *
+ *                                                                                                                     *
+ * PARAMETERS: words_grid - (in) pointer to words grid                                                                 *
+ *             word_id - (in) word ID                                                                                  *
+ *                                                                                                                     *
+ * RETURN: pointer to word string                                                                                      *
+ *                                                                                                                     *
+ * NOTES:                                                                                                              *
+ *                                                                                                                     *
+ ***********************************************************************************************************************/
+static char* gridWord (WordsGrid *words_grid, unsigned int word_id)
+{
+	if (words_grid->overlay != NULL)
 	{
-		for (j = 0; j < GRID_Y_LEN; j++)
-		{
-			grid_dest[i][j] = grid_src[i][j];
-		}
+		return WordListOverlay_GetWord(words_grid->overlay, word_id);
+	}
+
+	return WordList_GetWord(&(words_grid->word_list), word_id);
+}
+
+/***********************************************************************************************************************
+ *                                                                                                                     *
+ * FUNCTION: outputWord                                                                                                *
+ *                                                                                                                     *
+ * DESCRIPTION: output a found word (calls output_id_func, or output_func with the word string)                        *
+ *                                                                                                                     *
+ * PARAMETERS: words_grid - (in) pointer to words grid                                                                 *
+ *             word_id - (in) word ID of the found word                                                                *
+ *                                                                                                                     *
+ * RETURN: none                                                                                                        *
+ *                                                                                                                     *
+ * NOTES: the word string is looked up in the word list string table only here (at the output boundary)                *
+ *                                                                                                                     *
+ ***********************************************************************************************************************/
+static void outputWord (WordsGrid *words_grid, unsigned int word_id)
+{
+	if (words_grid->output_id_func != NULL)
+	{
+		words_grid->output_id_func(word_id);
+	}
+	else
+	{
+		words_grid->output_func(gridWord(words_grid, word_id));
 	}
 }
 
@@ -87,7 +261,8 @@ static void gridCopy (char grid_dest[][GRID_Y_LEN], char grid_src[][GRID_Y_LEN],
  *                                                                                  |k|l|n|z|                          *
  *                                                                                  +-------+                          *
  *                                                                                                                     *
- *             word - (in) prefix string, e.g.: "aband"                                                                *
+ *             char_node - (in) character node of the last character of prefix, e.g.: 'd' of "aband"                   *
+ *                         (the word list walked along the prefix - the prefix string itself is never built)           *
  *                                                                                                                     *
  *             i,j - (in) the x,y indices of the last character of prefix, e.g.: (1,3)                                 *
  *                                                                                                                     *
@@ -103,48 +278,46 @@ static void gridCopy (char grid_dest[][GRID_Y_LEN], char grid_src[][GRID_Y_LEN],
  *                                                                                  |o|o|o|o|                          *
  *                                                                                  +-------+                          *
  *                                                                                                                     *
+ *             word_len - (in) length of the prefix                                                                    *
+ *                                                                                                                     *
  * RETURN: none                                                                                                        *
  *                                                                                                                     *
- * NOTES:                                                                                                              *
+ * NOTES: prefixes shorter than the game rules min_len are not output, nor extended beyond max_len                     *
  *                                                                                                                     *
  ***********************************************************************************************************************/
-static void outputFoundWordsFromPrefix (WordsGrid *words_grid, char *word, int i, int j, char grid_ctrl[][GRID_Y_LEN], int size)
+static void outputFoundWordsFromPrefix (WordsGrid *words_grid, CharNode *char_node, int i, int j, char grid_ctrl[][GRID_Y_LEN], int size, int word_len)
 {
-	char grid_ctrl_next[GRID_X_LEN][GRID_Y_LEN];
-	char word_next[(GRID_X_LEN*GRID_Y_LEN)+1];
-	int word_found;
-	size_t word_len;
+	CharNode *next_node;
 	int x, y;
 	
-	word_found = WordList_FindWord(words_grid->word_list.char_tree, word);
-	if ((word_found == WORD_FOUND) || (word_found == PREFIX_FOUND))
+	if (isRulesWord(words_grid, char_node, word_len))
 	{
-		if (word_found == WORD_FOUND)
-		{
-			words_grid->output_func(word);
-		}
+		outputWord(words_grid, char_node->word_id);
+	}
+
+	/* no longer words with this prefix (or no longer words by the game rules) */
+	if ((char_node->next == NULL) || (word_len >= words_grid->rules.max_len))
+	{
+		return;
+	}
 		
-		/* init x and y to i and j */
-		x = i;
-		y = j;
+	/* init x and y to i and j */
+	x = i;
+	y = j;
 
-		/* in a loop: 1) find next adjacent cell 2) recursive call to outputFoundWordsFromPrefix */
-		while (getNextAdjacentUnusedCell(grid_ctrl,GRID_X_LEN,i,j,&x,&y))
+	/* in a loop: 1) find next adjacent cell 2) step one character down the word list 3) recursive call to outputFoundWordsFromPrefix */
+	while (getNextAdjacentUnusedCell(grid_ctrl,size,i,j,&x,&y))
+	{
+		next_node = WordList_FindChar(char_node->next, words_grid->grid[x][y]);
+		if (next_node != NULL)
 		{
-			/* prepare the next work */
-			word_len = strlen(word);
-			strcpy(word_next, word);
-			word_next[word_len] = words_grid->grid[x][y];
-			word_next[word_len+1] = '\0';
-			
-			/* prepare the next grid ctrl */
-			gridCopy(grid_ctrl_next, grid_ctrl, GRID_X_LEN);
-			grid_ctrl_next[x][y] = CELL_USED;
-			
-			outputFoundWordsFromPrefix(words_grid, word_next, x, y, grid_ctrl_next, GRID_X_LEN);
+			/* grid ctrl is marked for the recursive call and restored after it */
+			grid_ctrl[x][y] = CELL_USED;
+			outputFoundWordsFromPrefix(words_grid, next_node, x, y, grid_ctrl, size, word_len + 1);
+			grid_ctrl[x][y] = CELL_NOT_USED;
 		}
+		/* else: NOT_FOUND - no need to check further this prefix */
 	}
-	/* else: NOT_FOUND - no need to check further this prefix */
 }
 
 /***********************************************************************************************************************
@@ -244,56 +417,1755 @@ static int getNextAdjacentUnusedCell (char grid_ctrl[][GRID_Y_LEN], int size, in
 	return 0;
 }
 
-/*******************************************************************************************************************************************************/
-/************************************************************ external functions definition ************************************************************/
-/*******************************************************************************************************************************************************/
-RETURN_CODE WordsGrid_InitWordList (WordsGrid *words_grid, FILE *file)
+/***********************************************************************************************************************
+ *                                                                                                                     *
+ * FUNCTION: isRulesWord                                                                                               *
+ *                                                                                                                     *
+ * DESCRIPTION: is a found path a word by the game rules (a word of min_len characters or more)                        *
+ *                                                                                                                     *
+ * PARAMETERS: words_grid - (in) pointer to words grid                                                                 *
+ *             char_node - (in) character node of the last path character                                              *
+ *             word_len - (in) path length                                                                             *
+ *                                                                                                                     *
+ * RETURN: 1 - a word, 0 - a word prefix only                                                                          *
+ *                                                                                                                     *
+ * NOTES: a shorter word is kept in the result set as a prefix path (to be extended) - it is neither counted nor       *
+ *        scored                                                                                                       *
+ *                                                                                                                     *
+ ***********************************************************************************************************************/
+static int isRulesWord (WordsGrid *words_grid, CharNode *char_node, int word_len)
 {
-	return WordList_BuildCharTree(&(words_grid->word_list), file);
+	return (char_node->is_word && (word_len >= words_grid->rules.min_len));
 }
 
-void WordsGrid_SetGrid (WordsGrid *words_grid, const char *string)
+/***********************************************************************************************************************
+ *                                                                                                                     *
+ * FUNCTION: initResultSet                                                                                             *
+ *                                                                                                                     *
+ * DESCRIPTION: initialise an empty result set (nothing allocated)                                                     *
+ *                                                                                                                     *
+ * PARAMETERS: result_set - (out) pointer to result set                                                                *
+ *                                                                                                                     *
+ * RETURN: none                                                                                                        *
+ *                                                                                                                     *
+ * NOTES:                                                                                                              *
+ *                                                                                                                     *
+ ***********************************************************************************************************************/
+static void initResultSet (ResultSet *result_set)
 {
-	int i, j, k = 0;
-	
-	assert(strlen(string) == (GRID_X_LEN*GRID_Y_LEN));
-	
-	for (i = 0; i < GRID_X_LEN; i++)
+	memset(result_set, 0, sizeof(ResultSet));
+}
+
+/***********************************************************************************************************************
+ *                                                                                                                     *
+ * FUNCTION: clearResultSet                                                                                            *
+ *                                                                                                                     *
+ * DESCRIPTION: empty a result set (allocated memory is kept for the next solve)                                       *
+ *                                                                                                                     *
+ * PARAMETERS: result_set - (in/out) pointer to result set                                                             *
+ *                                                                                                                     *
+ * RETURN: none                                                                                                        *
+ *                                                                                                                     *
+ * NOTES:                                                                                                              *
+ *                                                                                                                     *
+ ***********************************************************************************************************************/
+static void clearResultSet (ResultSet *result_set)
+{
+	result_set->no_of_found_paths = 0;
+	result_set->no_of_lost_words = 0;
+	result_set->no_of_words = 0;
+	result_set->score = 0;
+
+	if (result_set->word_counts != NULL)
 	{
-		for (j = 0; j < GRID_Y_LEN; j++)
+		memset(result_set->word_counts, 0, result_set->word_counts_size * sizeof(WordCount));
+	}
+	result_set->word_counts_used = 0;
+}
+
+/***********************************************************************************************************************
+ *                                                                                                                     *
+ * FUNCTION: freeResultSet                                                                                             *
+ *                                                                                                                     *
+ * DESCRIPTION: free memory dynamically allocated for a result set                                                     *
+ *                                                                                                                     *
+ * PARAMETERS: result_set - (in/out) pointer to result set                                                             *
+ *                                                                                                                     *
+ * RETURN: none                                                                                                        *
+ *                                                                                                                     *
+ * NOTES:                                                                                                              *
+ *                                                                                                                     *
+ ***********************************************************************************************************************/
+static void freeResultSet (ResultSet *result_set)
+{
+	free(result_set->found_paths);
+	free(result_set->word_counts);
+	free(result_set->lost_words);
+
+	initResultSet(result_set);
+}
+
+/***********************************************************************************************************************
+ *                                                                                                                     *
+ * FUNCTION: growWordCounts                                                                                            *
+ *                                                                                                                     *
+ * DESCRIPTION: re-hash the found words per word hash table into a larger table                                        *
+ *              (entries of words that are no longer found are dropped)                                                *
+ *                                                                                                                     *
+ * PARAMETERS: result_set - (in/out) pointer to result set                                                             *
+ *                                                                                                                     *
+ * RETURN: RC_NO_ERROR - no error                                                                                      *
+ *         RC_NO_MEM - no memory (hash table is left unchanged)                                                        *
+ *                                                                                                                     *
+ * NOTES:                                                                                                              *
+ *                                                                                                                     *
+ ***********************************************************************************************************************/
+static RETURN_CODE growWordCounts (ResultSet *result_set)
+{
+	WordCount *old_word_counts = result_set->word_counts;
+	size_t old_size = result_set->word_counts_size;
+	size_t live = 0, new_size, k;
+	WordCount *word_count;
+
+	for (k = 0; k < old_size; k++)
+	{
+		if ((old_word_counts[k].count != 0) || (old_word_counts[k].lost))
 		{
-			words_grid->grid[i][j] = string[k++];
+			live++;
+		}
+	}
+
+	/* keep the table at most 1/4 full after re-hash */
+	for (new_size = WORD_COUNTS_MIN_SIZE; new_size < (4 * (live + 1)); new_size *= 2);
+
+	result_set->word_counts = (WordCount*)calloc(new_size, sizeof(WordCount));
+	if (result_set->word_counts == NULL)
+	{
+		result_set->word_counts = old_word_counts;
+		return RC_NO_MEM;
+	}
+	result_set->word_counts_size = new_size;
+	result_set->word_counts_used = 0;
+
+	for (k = 0; k < old_size; k++)
+	{
+		if ((old_word_counts[k].count != 0) || (old_word_counts[k].lost))
+		{
+			word_count = findWordCount(result_set, old_word_counts[k].word_node, 1);
+			assert(word_count);
+			*word_count = old_word_counts[k];
 		}
 	}
+
+	free(old_word_counts);
+
+	return RC_NO_ERROR;
 }
 
-void WordsGrid_SetOutputFunc (WordsGrid *words_grid, void (*output_func) (char *word))
+/***********************************************************************************************************************
+ *                                                                                                                     *
+ * FUNCTION: findWordCount                                                                                             *
+ *                                                                                                                     *
+ * DESCRIPTION: find (or add) the found words count entry of a word in a result set                                    *
+ *                                                                                                                     *
+ * PARAMETERS: result_set - (in/out) pointer to result set                                                             *
+ *             word_node - (in) terminal character node of the word                                                    *
+ *             add - (in) yes/no add a new (zero count) entry if the word has none                                     *
+ *                                                                                                                     *
+ * RETURN: pointer to the word count entry (or NULL if not found or could not be allocated)                            *
+ *                                                                                                                     *
+ * NOTES: a pointer returned is valid until the next call that adds an entry                                           *
+ *                                                                                                                     *
+ ***********************************************************************************************************************/
+static WordCount* findWordCount (ResultSet *result_set, CharNode *word_node, int add)
 {
-	words_grid->output_func = output_func;
+	WordCount *word_count;
+	size_t k;
+
+	if (add && ((2 * (result_set->word_counts_used + 1)) > result_set->word_counts_size))
+	{
+		if (growWordCounts(result_set) != RC_NO_ERROR)
+		{
+			return NULL;
+		}
+	}
+
+	if (result_set->word_counts_size == 0)
+	{
+		return NULL;
+	}
+
+	/* linear probing from the (multiplicative) hash of the node address */
+	k = (((size_t)word_node / sizeof(CharNode)) * 2654435761u) & (result_set->word_counts_size - 1);
+	for (word_count = &(result_set->word_counts[k]); word_count->word_node != NULL; word_count = &(result_set->word_counts[k]))
+	{
+		if (word_count->word_node == word_node)
+		{
+			return word_count;
+		}
+		k = (k + 1) & (result_set->word_counts_size - 1);
+	}
+
+	if (!add)
+	{
+		return NULL;
+	}
+
+	word_count->word_node = word_node;
+	word_count->count = 0;
+	word_count->lost = 0;
+	result_set->word_counts_used++;
+
+	return word_count;
 }
 
-void WordsGrid_OutputFoundWords (WordsGrid *words_grid)
+/***********************************************************************************************************************
+ *                                                                                                                     *
+ * FUNCTION: pathUsesCell                                                                                              *
+ *                                                                                                                     *
+ * DESCRIPTION: check if a found path passes through a grid cell                                                       *
+ *                                                                                                                     *
+ * PARAMETERS: found_path - (in) pointer to found path                                                                 *
+ *             cell - (in) grid cell index                                                                             *
+ *                                                                                                                     *
+ * RETURN: 0 - cell not used                                                                                           *
+ *         1 - cell used                                                                                               *
+ *                                                                                                                     *
+ * NOTES:                                                                                                              *
+ *                                                                                                                     *
+ ***********************************************************************************************************************/
+static int pathUsesCell (FoundPath *found_path, CellIndex cell)
 {
-   char grid_ctrl[GRID_X_LEN][GRID_Y_LEN];
-   char word[(GRID_X_LEN*GRID_Y_LEN)+1];
-   int i, j;
-   
-   for (i = 0; i < GRID_X_LEN; i++)
-   {
-	   for (j = 0; j < GRID_Y_LEN; j++)
-	   {
-		   initGridCtrl(grid_ctrl, GRID_X_LEN);
-		   grid_ctrl[i][j] = CELL_USED;
-		   
-		   word[0] = words_grid->grid[i][j];
-		   word[1] = '\0';
-		   
-		   outputFoundWordsFromPrefix(words_grid, word, i, j, grid_ctrl, GRID_X_LEN);
-	   }
-   }
+	int k;
+
+	for (k = 0; k < found_path->path_len; k++)
+	{
+		if (found_path->path[k] == cell)
+		{
+			return 1;
+		}
+	}
+
+	return 0;
+}
+
+/***********************************************************************************************************************
+ *                                                                                                                     *
+ * FUNCTION: addFoundPath                                                                                              *
+ *                                                                                                                     *
+ * DESCRIPTION: add a found path to the words grid result set (and score its word if it is found for the first time)   *
+ *                                                                                                                     *
+ * PARAMETERS: words_grid - (in/out) pointer to words grid                                                             *
+ *             char_node - (in) character node of the last path character                                              *
+ *             path, path_len - (in) grid cells of the found path                                                      *
+ *             delta - (in/out) delta to count a gained word to (or NULL)                                              *
+ *                                                                                                                     *
+ * RETURN: RC_NO_ERROR - no error                                                                                      *
+ *         RC_NO_MEM - no memory                                                                                       *
+ *                                                                                                                     *
+ * NOTES: a word dropped earlier by the same cell change (lost) and found again is neither gained nor lost             *
+ *                                                                                                                     *
+ ***********************************************************************************************************************/
+static RETURN_CODE addFoundPath (WordsGrid *words_grid, CharNode *char_node, CellIndex *path, int path_len, WordsGridDelta *delta)
+{
+	ResultSet *result_set = &(words_grid->result_set);
+	FoundPath *found_path;
+	WordCount *word_count = NULL;
+	size_t allocated;
+
+	if (result_set->no_of_found_paths == result_set->allocated_found_paths)
+	{
+		allocated = (result_set->allocated_found_paths == 0)? 1024: (2 * result_set->allocated_found_paths);
+		found_path = (FoundPath*)realloc(result_set->found_paths, allocated * sizeof(FoundPath));
+		if (found_path == NULL)
+		{
+			return RC_NO_MEM;
+		}
+		result_set->found_paths = found_path;
+		result_set->allocated_found_paths = allocated;
+	}
+
+	if (isRulesWord(words_grid, char_node, path_len))
+	{
+		word_count = findWordCount(result_set, char_node, 1);
+		if (word_count == NULL)
+		{
+			return RC_NO_MEM;
+		}
+	}
+
+	found_path = &(result_set->found_paths[result_set->no_of_found_paths++]);
+	found_path->char_node = char_node;
+	found_path->path_len = (unsigned char)path_len;
+	memcpy(found_path->path, path, path_len * sizeof(CellIndex));
+
+	if ((word_count != NULL) && (word_count->count++ == 0))
+	{
+		result_set->no_of_words++;
+		result_set->score += words_grid->rules.scores[path_len];
+
+		if (word_count->lost)
+		{
+			word_count->lost = 0;
+		}
+		else if (delta != NULL)
+		{
+			delta->words_gained++;
+			if (words_grid->delta_func != NULL)
+			{
+				words_grid->delta_func(gridWord(words_grid, char_node->word_id), 1);
+			}
+		}
+	}
+
+	return RC_NO_ERROR;
+}
+
+/***********************************************************************************************************************
+ *                                                                                                                     *
+ * FUNCTION: addLostWord                                                                                               *
+ *                                                                                                                     *
+ * DESCRIPTION: keep the last dropped path of a word that is no longer found (until the cell change is done)           *
+ *                                                                                                                     *
+ * PARAMETERS: result_set - (in/out) pointer to result set                                                             *
+ *             found_path - (in) pointer to the dropped found path                                                     *
+ *                                                                                                                     *
+ * RETURN: RC_NO_ERROR - no error                                                                                      *
+ *         RC_NO_MEM - no memory                                                                                       *
+ *                                                                                                                     *
+ * NOTES:                                                                                                              *
+ *                                                                                                                     *
+ ***********************************************************************************************************************/
+static RETURN_CODE addLostWord (ResultSet *result_set, FoundPath *found_path)
+{
+	FoundPath *lost_words;
+	size_t allocated;
+
+	if (result_set->no_of_lost_words == result_set->allocated_lost_words)
+	{
+		allocated = (result_set->allocated_lost_words == 0)? 64: (2 * result_set->allocated_lost_words);
+		lost_words = (FoundPath*)realloc(result_set->lost_words, allocated * sizeof(FoundPath));
+		if (lost_words == NULL)
+		{
+			return RC_NO_MEM;
+		}
+		result_set->lost_words = lost_words;
+		result_set->allocated_lost_words = allocated;
+	}
+
+	result_set->lost_words[result_set->no_of_lost_words++] = *found_path;
+
+	return RC_NO_ERROR;
+}
+
+/***********************************************************************************************************************
+ *                                                                                                                     *
+ * FUNCTION: addSearchPath                                                                                             *
+ *                                                                                                                     *
+ * DESCRIPTION: path search found function - add the current path to the words grid result set                         *
+ *                                                                                                                     *
+ * PARAMETERS: words_grid - (in/out) pointer to words grid                                                             *
+ *             search - (in) path search state                                                                         *
+ *             char_node - (in) character node of the last path character                                              *
+ *                                                                                                                     *
+ * RETURN: RC_NO_ERROR - no error                                                                                      *
+ *         RC_NO_MEM - no memory                                                                                       *
+ *                                                                                                                     *
+ * NOTES:                                                                                                              *
+ *                                                                                                                     *
+ ***********************************************************************************************************************/
+static RETURN_CODE addSearchPath (WordsGrid *words_grid, PathSearch *search, CharNode *char_node)
+{
+	return addFoundPath(words_grid, char_node, search->path, search->path_len, search->delta);
+}
+
+/***********************************************************************************************************************
+ *                                                                                                                     *
+ * FUNCTION: outputSearchPath                                                                                          *
+ *                                                                                                                     *
+ * DESCRIPTION: path search found function - output the current path if it is a word (and add it to the grid cache     *
+ *              in canonical grid cells)                                                                               *
+ *                                                                                                                     *
+ * PARAMETERS: words_grid - (in/out) pointer to words grid                                                             *
+ *             search - (in) path search state                                                                         *
+ *             char_node - (in) character node of the last path character                                              *
+ *                                                                                                                     *
+ * RETURN: RC_NO_ERROR - no error                                                                                      *
+ *                                                                                                                     *
+ * NOTES:                                                                                                              *
+ *                                                                                                                     *
+ ***********************************************************************************************************************/
+static RETURN_CODE outputSearchPath (WordsGrid *words_grid, PathSearch *search, CharNode *char_node)
+{
+	CellIndex canonical_path[MAX_PATH_LEN];
+	int k;
+
+	if (isRulesWord(words_grid, char_node, search->path_len))
+	{
+		if (words_grid->path_output_func != NULL)
+		{
+			words_grid->path_output_func(gridWord(words_grid, char_node->word_id), search->path, search->path_len);
+		}
+		else
+		{
+			outputWord(words_grid, char_node->word_id);
+		}
+
+		if (search->builder != NULL)
+		{
+			for (k = 0; (k < search->path_len) && search->builder->with_paths; k++)
+			{
+				canonical_path[k] = GridCache_MapCell(search->symmetry, search->path[k]);
+			}
+			GridCache_AddPath(search->builder, char_node->word_id, canonical_path, search->path_len);
+		}
+	}
+
+	return RC_NO_ERROR;
+}
+
+/***********************************************************************************************************************
+ *                                                                                                                     *
+ * FUNCTION: searchPathsFromNode                                                                                       *
+ *                                                                                                                     *
+ * DESCRIPTION: add to the result set the current path followed by cell (i,j) and all the found paths that start       *
+ *              with it                                                                                                *
+ *                                                                                                                     *
+ * PARAMETERS: words_grid - (in/out) pointer to words grid                                                             *
+ *             search - (in/out) path search state (current path and grid control)                                     *
+ *             char_node - (in) character node of cell (i,j) (the word list walked along the current path)             *
+ *             i,j - (in) the x,y indices of the next cell of the path                                                 *
+ *                                                                                                                     *
+ * RETURN: none (search->ret_code is set on error)                                                                     *
+ *                                                                                                                     *
+ * NOTES: paths are not extended beyond the game rules max_len                                                         *
+ *                                                                                                                     *
+ ***********************************************************************************************************************/
+static void searchPathsFromNode (WordsGrid *words_grid, PathSearch *search, CharNode *char_node, int i, int j)
+{
+	CharNode *next_node;
+	int x, y;
+
+	search->path[search->path_len++] = (CellIndex)((i * GRID_Y_LEN) + j);
+	search->grid_ctrl[i][j] = CELL_USED;
+
+	search->ret_code = search->found_func(words_grid, search, char_node);
+
+	if ((char_node->next != NULL) && (search->path_len < words_grid->rules.max_len))
+	{
+		x = i;
+		y = j;
+
+		while ((search->ret_code == RC_NO_ERROR) && getNextAdjacentUnusedCell(search->grid_ctrl, GRID_X_LEN, i, j, &x, &y))
+		{
+			next_node = WordList_FindChar(char_node->next, words_grid->grid[x][y]);
+			if (next_node != NULL)
+			{
+				searchPathsFromNode(words_grid, search, next_node, x, y);
+			}
+		}
+	}
+
+	search->grid_ctrl[i][j] = CELL_NOT_USED;
+	search->path_len--;
+}
+
+/***********************************************************************************************************************
+ *                                                                                                                     *
+ * FUNCTION: searchAllPaths                                                                                            *
+ *                                                                                                                     *
+ * DESCRIPTION: search all found paths from every start cell                                                           *
+ *                                                                                                                     *
+ * PARAMETERS: words_grid - (in/out) pointer to words grid                                                             *
+ *             search - (in/out) path search state (found function and its arguments set)                              *
+ *                                                                                                                     *
+ * RETURN: RC_NO_ERROR - no error                                                                                      *
+ *         RC_NO_MEM - no memory                                                                                       *
+ *                                                                                                                     *
+ * NOTES:                                                                                                              *
+ *                                                                                                                     *
+ ***********************************************************************************************************************/
+static RETURN_CODE searchAllPaths (WordsGrid *words_grid, PathSearch *search)
+{
+	CharNode *char_node;
+	int i, j;
+
+	initGridCtrl(search->grid_ctrl, GRID_X_LEN);
+	search->path_len = 0;
+	search->ret_code = RC_NO_ERROR;
+
+	for (i = 0; (i < GRID_X_LEN) && (search->ret_code == RC_NO_ERROR); i++)
+	{
+		for (j = 0; (j < GRID_Y_LEN) && (search->ret_code == RC_NO_ERROR); j++)
+		{
+			char_node = WordList_FindChar(gridCharTree(words_grid), words_grid->grid[i][j]);
+			if (char_node != NULL)
+			{
+				searchPathsFromNode(words_grid, search, char_node, i, j);
+			}
+		}
+	}
+
+	return search->ret_code;
+}
+
+/***********************************************************************************************************************
+ *                                                                                                                     *
+ * FUNCTION: searchPathsThroughCell                                                                                    *
+ *                                                                                                                     *
+ * DESCRIPTION: add to the result set all found paths that pass through cell (x,y)                                     *
+ *              (every such path is a kept prefix path that ends next to (x,y), followed by (x,y) and its extensions)  *
+ *                                                                                                                     *
+ * PARAMETERS: words_grid - (in/out) pointer to words grid (result set holds no path that passes through (x,y))        *
+ *             x,y - (in) the indices of the cell                                                                      *
+ *             delta - (in/out) delta to count gained words to                                                         *
+ *                                                                                                                     *
+ * RETURN: RC_NO_ERROR - no error                                                                                      *
+ *         RC_NO_MEM - no memory                                                                                       *
+ *                                                                                                                     *
+ * NOTES:                                                                                                              *
+ *                                                                                                                     *
+ ***********************************************************************************************************************/
+static RETURN_CODE searchPathsThroughCell (WordsGrid *words_grid, int x, int y, WordsGridDelta *delta)
+{
+	ResultSet *result_set = &(words_grid->result_set);
+	PathSearch search;
+	CharNode *char_node;
+	FoundPath *found_path;
+	size_t k, no_of_kept_paths;
+	int last_x, last_y, n;
+
+	initGridCtrl(search.grid_ctrl, GRID_X_LEN);
+	search.found_func = addSearchPath;
+	search.path_len = 0;
+	search.delta = delta;
+	search.symmetry = 0;
+	search.builder = NULL;
+	search.worker = NULL;
+	search.ret_code = RC_NO_ERROR;
+
+	/* paths that start at (x,y) */
+	char_node = WordList_FindChar(gridCharTree(words_grid), words_grid->grid[x][y]);
+	if (char_node != NULL)
+	{
+		searchPathsFromNode(words_grid, &search, char_node, x, y);
+	}
+
+	/* paths that continue a kept prefix path into (x,y) (the paths added here are not extended again) */
+	no_of_kept_paths = result_set->no_of_found_paths;
+	for (k = 0; (k < no_of_kept_paths) && (search.ret_code == RC_NO_ERROR); k++)
+	{
+		found_path = &(result_set->found_paths[k]);
+
+		last_x = found_path->path[found_path->path_len - 1] / GRID_Y_LEN;
+		last_y = found_path->path[found_path->path_len - 1] % GRID_Y_LEN;
+		if ((abs(last_x - x) > 1) || (abs(last_y - y) > 1) || (found_path->path_len >= words_grid->rules.max_len) ||
+			(found_path->char_node->next == NULL) || pathUsesCell(found_path, (CellIndex)((x * GRID_Y_LEN) + y)))
+		{
+			continue;
+		}
+
+		char_node = WordList_FindChar(found_path->char_node->next, words_grid->grid[x][y]);
+		if (char_node != NULL)
+		{
+			/* restore the kept path as the current path (copied - found_paths may be re-allocated by the search) */
+			search.path_len = found_path->path_len;
+			memcpy(search.path, found_path->path, search.path_len * sizeof(CellIndex));
+			for (n = 0; n < search.path_len; n++)
+			{
+				search.grid_ctrl[search.path[n] / GRID_Y_LEN][search.path[n] % GRID_Y_LEN] = CELL_USED;
+			}
+
+			searchPathsFromNode(words_grid, &search, char_node, x, y);
+
+			for (n = 0; n < search.path_len; n++)
+			{
+				search.grid_ctrl[search.path[n] / GRID_Y_LEN][search.path[n] % GRID_Y_LEN] = CELL_NOT_USED;
+			}
+		}
+	}
+
+	return search.ret_code;
+}
+
+/***********************************************************************************************************************
+ *                                                                                                                     *
+ * FUNCTION: searchOrderKey                                                                                            *
+ *                                                                                                                     *
+ * DESCRIPTION: search order key of a path: its start cell (2 bytes) and the direction of every step (1..8 in the      *
+ *              order of getNextAdjacentUnusedCell), padded with 0                                                     *
+ *                                                                                                                     *
+ * PARAMETERS: path, path_len - (in) grid cells of the path                                                            *
+ *             key - (out) key (MAX_PATH_LEN+1 bytes)                                                                  *
+ *                                                                                                                     *
+ * RETURN: none                                                                                                        *
+ *                                                                                                                     *
+ * NOTES: a path is a prefix of its extensions and so its key is less than theirs (0 padding)                          *
+ *                                                                                                                     *
+ ***********************************************************************************************************************/
+static void searchOrderKey (CellIndex *path, int path_len, unsigned char *key)
+{
+	/* direction of a step by (dx+1, dy+1) */
+	static const unsigned char directions[3][3] = {{8, 1, 2}, {7, 0, 3}, {6, 5, 4}};
+	int n;
+
+	memset(key, 0, MAX_PATH_LEN+1);
+	key[0] = (unsigned char)(path[0] >> 8);
+	key[1] = (unsigned char)(path[0] & 0xFF);
+
+	for (n = 1; n < path_len; n++)
+	{
+		key[n+1] = directions[(path[n] / GRID_Y_LEN) - (path[n-1] / GRID_Y_LEN) + 1][(path[n] % GRID_Y_LEN) - (path[n-1] % GRID_Y_LEN) + 1];
+	}
+}
+
+/***********************************************************************************************************************
+ *                                                                                                                     *
+ * FUNCTION: compareSearchOrderKeys                                                                                    *
+ *                                                                                                                     *
+ * DESCRIPTION: qsort compare function of search order keys                                                            *
+ *                                                                                                                     *
+ * PARAMETERS: key1, key2 - (in) pointers to search order keys                                                         *
+ *                                                                                                                     *
+ * RETURN: <0, 0, >0                                                                                                   *
+ *                                                                                                                     *
+ * NOTES:                                                                                                              *
+ *                                                                                                                     *
+ ***********************************************************************************************************************/
+static int compareSearchOrderKeys (const void *key1, const void *key2)
+{
+	return memcmp(((const SearchOrderKey*)key1)->key, ((const SearchOrderKey*)key2)->key, MAX_PATH_LEN+1);
+}
+
+/***********************************************************************************************************************
+ *                                                                                                                     *
+ * FUNCTION: outputCachedWords                                                                                         *
+ *                                                                                                                     *
+ * DESCRIPTION: output (using output function) the found words of a grid cache entry - in the search order of grid     *
+ *              (as WordsGrid_OutputFoundWords with no grid cache)                                                     *
+ *                                                                                                                     *
+ * PARAMETERS: words_grid - (in) pointer to words grid                                                                 *
+ *             entry - (in) grid cache entry of the canonical grid of words grid                                       *
+ *                                                                                                                     *
+ * RETURN: none                                                                                                        *
+ *                                                                                                                     *
+ * NOTES: paths are mapped from canonical grid cells back to grid cells (by the inverse symmetry); the paths of an     *
+ *        entry solved from a grid of another symmetry are sorted by their search order keys in grid (or output in     *
+ *        the entry order if no memory)                                                                                *
+ *        the words of an entry of word IDs only are output in the entry order (the search order of the solved grid)   *
+ *                                                                                                                     *
+ ***********************************************************************************************************************/
+static void outputCachedWords (WordsGrid *words_grid, GridCacheEntry *entry)
+{
+	CellIndex grid_cells[GRID_CELLS];
+	CellIndex path[MAX_PATH_LEN];
+	CellIndex *cells;
+	SearchOrderKey *keys = NULL;
+	int symmetry = words_grid->symmetry;
+	size_t k, p, offset;
+	int n;
+
+	if (entry->cells == NULL)
+	{
+		for (k = 0; k < entry->no_of_paths; k++)
+		{
+			outputWord(words_grid, entry->word_ids[k]);
+		}
+		return;
+	}
+
+	/* the inverse symmetry: canonical grid cell -> grid cell */
+	for (n = 0; n < GRID_CELLS; n++)
+	{
+		grid_cells[GridCache_MapCell(symmetry, (CellIndex)n)] = (CellIndex)n;
+	}
+
+	if ((symmetry != entry->symmetry) && (entry->no_of_paths > 1))
+	{
+		keys = (SearchOrderKey*)malloc(entry->no_of_paths * sizeof(SearchOrderKey));
+	}
+
+	if (keys != NULL)
+	{
+		for (k = 0, offset = 0; k < entry->no_of_paths; offset += entry->path_lens[k], k++)
+		{
+			for (n = 0; n < entry->path_lens[k]; n++)
+			{
+				path[n] = grid_cells[entry->cells[offset + n]];
+			}
+			searchOrderKey(path, entry->path_lens[k], keys[k].key);
+			keys[k].path = (unsigned int)k;
+			keys[k].offset = (unsigned int)offset;
+		}
+		qsort(keys, entry->no_of_paths, sizeof(SearchOrderKey), compareSearchOrderKeys);
+	}
+
+	for (k = 0, offset = 0; k < entry->no_of_paths; offset += entry->path_lens[k], k++)
+	{
+		p = (keys != NULL)? keys[k].path: k;
+		cells = entry->cells + ((keys != NULL)? keys[k].offset: offset);
+
+		if (words_grid->path_output_func == NULL)
+		{
+			outputWord(words_grid, entry->word_ids[p]);
+			continue;
+		}
+
+		for (n = 0; n < entry->path_lens[p]; n++)
+		{
+			path[n] = grid_cells[cells[n]];
+		}
+		words_grid->path_output_func(gridWord(words_grid, entry->word_ids[p]), path, entry->path_lens[p]);
+	}
+
+	free(keys);
+}
+
+/***********************************************************************************************************************
+ *                                                                                                                     *
+ * FUNCTION: findWordFromCell                                                                                          *
+ *                                                                                                                     *
+ * DESCRIPTION: find the rest of a word in grid from a cell (the word so far ends at the cell)                         *
+ *                                                                                                                     *
+ * PARAMETERS: words_grid - (in) pointer to words grid                                                                 *
+ *             word - (in) rest of the word                                                                            *
+ *             i,j - (in) the x,y indices of the cell                                                                  *
+ *             grid_ctrl - (in/out) grid control (cells of the path marked as used)                                    *
+ *             path, path_len - (in/out) path of the word so far                                                       *
+ *                                                                                                                     *
+ * RETURN: path length of the word (0 if the rest of the word is not found)                                            *
+ *                                                                                                                     *
+ * NOTES:                                                                                                              *
+ *                                                                                                                     *
+ ***********************************************************************************************************************/
+static int findWordFromCell (WordsGrid *words_grid, char *word, int i, int j, char grid_ctrl[][GRID_Y_LEN], CellIndex *path, int path_len)
+{
+	int x, y, found_len = 0;
+
+	if (*word == '\0')
+	{
+		return path_len;
+	}
+
+	x = i;
+	y = j;
+
+	while ((found_len == 0) && getNextAdjacentUnusedCell(grid_ctrl, GRID_X_LEN, i, j, &x, &y))
+	{
+		if (words_grid->grid[x][y] == *word)
+		{
+			grid_ctrl[x][y] = CELL_USED;
+			path[path_len] = (CellIndex)((x * GRID_Y_LEN) + y);
+			found_len = findWordFromCell(words_grid, word + 1, x, y, grid_ctrl, path, path_len + 1);
+			grid_ctrl[x][y] = CELL_NOT_USED;
+		}
+	}
+
+	return found_len;
+}
+
+/***********************************************************************************************************************
+ *                                                                                                                     *
+ * FUNCTION: findWordPath                                                                                              *
+ *                                                                                                                     *
+ * DESCRIPTION: find a path of a word in grid (from every start cell of its first letter)                              *
+ *                                                                                                                     *
+ * PARAMETERS: words_grid - (in) pointer to words grid                                                                 *
+ *             word - (in) word to find (not empty, not longer than MAX_PATH_LEN)                                      *
+ *             path - (out) grid cells of the word                                                                     *
+ *                                                                                                                     *
+ * RETURN: path length (0 if the word is not in grid)                                                                  *
+ *                                                                                                                     *
+ * NOTES:                                                                                                              *
+ *                                                                                                                     *
+ ***********************************************************************************************************************/
+static int findWordPath (WordsGrid *words_grid, char *word, CellIndex *path)
+{
+	char grid_ctrl[GRID_X_LEN][GRID_Y_LEN];
+	int i, j, path_len = 0;
+
+	initGridCtrl(grid_ctrl, GRID_X_LEN);
+
+	for (i = 0; (i < GRID_X_LEN) && (path_len == 0); i++)
+	{
+		for (j = 0; (j < GRID_Y_LEN) && (path_len == 0); j++)
+		{
+			if (words_grid->grid[i][j] == word[0])
+			{
+				grid_ctrl[i][j] = CELL_USED;
+				path[0] = (CellIndex)((i * GRID_Y_LEN) + j);
+				path_len = findWordFromCell(words_grid, word + 1, i, j, grid_ctrl, path, 1);
+				grid_ctrl[i][j] = CELL_NOT_USED;
+			}
+		}
+	}
+
+	return path_len;
+}
+
+/***********************************************************************************************************************
+ *                                                                                                                     *
+ * FUNCTION: gridLetterMask                                                                                            *
+ *                                                                                                                     *
+ * DESCRIPTION: letter mask of the grid letters                                                                        *
+ *                                                                                                                     *
+ * PARAMETERS: words_grid - (in) pointer to words grid                                                                 *
+ *                                                                                                                     *
+ * RETURN: letter mask (RackIndex_LetterMask)                                                                          *
+ *                                                                                                                     *
+ * NOTES:                                                                                                              *
+ *                                                                                                                     *
+ ***********************************************************************************************************************/
+static unsigned int gridLetterMask (WordsGrid *words_grid)
+{
+	char cell[2] = {'\0', '\0'};
+	unsigned int grid_mask = 0;
+	int i, j;
+
+	for (i = 0; i < GRID_X_LEN; i++)
+	{
+		for (j = 0; j < GRID_Y_LEN; j++)
+		{
+			cell[0] = words_grid->grid[i][j];
+			grid_mask |= RackIndex_LetterMask(cell);
+		}
+	}
+
+	return grid_mask;
+}
+
+/***********************************************************************************************************************
+ *                                                                                                                     *
+ * FUNCTION: setCanonicalGrid                                                                                          *
+ *                                                                                                                     *
+ * DESCRIPTION: set the canonical grid of the grid and the symmetry that maps the grid to it (if a grid cache is set)  *
+ *                                                                                                                     *
+ * PARAMETERS: words_grid - (in/out) pointer to words grid                                                             *
+ *                                                                                                                     *
+ * RETURN: none                                                                                                        *
+ *                                                                                                                     *
+ * NOTES: called on every change of the grid - the grid is canonicalized once, not on every cached search              *
+ *                                                                                                                     *
+ ***********************************************************************************************************************/
+static void setCanonicalGrid (WordsGrid *words_grid)
+{
+	if (words_grid->grid_cache != NULL)
+	{
+		words_grid->symmetry = GridCache_CanonicalGrid(words_grid->grid, words_grid->canonical_grid);
+	}
+}
+
+/***********************************************************************************************************************
+ *                                                                                                                     *
+ * FUNCTION: addSearchTask                                                                                             *
+ *                                                                                                                     *
+ * DESCRIPTION: add the current path of a path search as a task of a parallel search                                   *
+ *                                                                                                                     *
+ * PARAMETERS: parallel - (in/out) pointer to parallel search                                                          *
+ *             search - (in) path search state (current path)                                                          *
+ *             char_node - (in) character node of the last path character                                              *
+ *             subtree - (in) 1 - the task is the path and all its extensions, 0 - the path only                       *
+ *                                                                                                                     *
+ * RETURN: RC_NO_ERROR - no error                                                                                      *
+ *         RC_NO_MEM - no memory                                                                                       *
+ *                                                                                                                     *
+ * NOTES:                                                                                                              *
+ *                                                                                                                     *
+ ***********************************************************************************************************************/
+static RETURN_CODE addSearchTask (ParallelSearch *parallel, PathSearch *search, CharNode *char_node, int subtree)
+{
+	SearchTask *tasks, *task;
+	size_t allocated;
+
+	if (parallel->no_of_tasks == parallel->allocated_tasks)
+	{
+		allocated = (parallel->allocated_tasks == 0)? GRID_CELLS: (2 * parallel->allocated_tasks);
+		tasks = (SearchTask*)realloc(parallel->tasks, allocated * sizeof(SearchTask));
+		if (tasks == NULL)
+		{
+			return RC_NO_MEM;
+		}
+		parallel->tasks = tasks;
+		parallel->allocated_tasks = allocated;
+	}
+
+	task = &(parallel->tasks[parallel->no_of_tasks++]);
+	memcpy(task->path, search->path, search->path_len * sizeof(CellIndex));
+	task->path_len = search->path_len;
+	task->char_node = char_node;
+	task->subtree = subtree;
+	task->no_of_words = 0;
+
+	return RC_NO_ERROR;
+}
+
+/***********************************************************************************************************************
+ *                                                                                                                     *
+ * FUNCTION: splitSearchFromNode                                                                                       *
+ *                                                                                                                     *
+ * DESCRIPTION: split the search of the current path followed by cell (i,j) into parallel search tasks (in the order   *
+ *              of the serial search)                                                                                  *
+ *                                                                                                                     *
+ * PARAMETERS: parallel - (in/out) pointer to parallel search                                                          *
+ *             search - (in/out) path search state (current path and grid control)                                     *
+ *             char_node - (in) character node of cell (i,j)                                                           *
+ *             i,j - (in) the x,y indices of the next cell of the path                                                 *
+ *                                                                                                                     *
+ * RETURN: RC_NO_ERROR - no error                                                                                      *
+ *         RC_NO_MEM - no memory                                                                                       *
+ *                                                                                                                     *
+ * NOTES: a path of SEARCH_TASK_STEPS steps (or with no extensions by the game rules) is a task with its extensions;   *
+ *        a shorter word path is a task of its own, followed by the tasks of its extensions                            *
+ *                                                                                                                     *
+ ***********************************************************************************************************************/
+static RETURN_CODE splitSearchFromNode (ParallelSearch *parallel, PathSearch *search, CharNode *char_node, int i, int j)
+{
+	CharNode *next_node;
+	RETURN_CODE ret_code = RC_NO_ERROR;
+	int x, y;
+
+	search->path[search->path_len++] = (CellIndex)((i * GRID_Y_LEN) + j);
+	search->grid_ctrl[i][j] = CELL_USED;
+
+	if ((search->path_len > SEARCH_TASK_STEPS) || (char_node->next == NULL) || (search->path_len >= parallel->words_grid->rules.max_len))
+	{
+		ret_code = addSearchTask(parallel, search, char_node, 1);
+	}
+	else
+	{
+		if (isRulesWord(parallel->words_grid, char_node, search->path_len))
+		{
+			ret_code = addSearchTask(parallel, search, char_node, 0);
+		}
+
+		x = i;
+		y = j;
+
+		while ((ret_code == RC_NO_ERROR) && getNextAdjacentUnusedCell(search->grid_ctrl, GRID_X_LEN, i, j, &x, &y))
+		{
+			next_node = WordList_FindChar(char_node->next, parallel->words_grid->grid[x][y]);
+			if (next_node != NULL)
+			{
+				ret_code = splitSearchFromNode(parallel, search, next_node, x, y);
+			}
+		}
+	}
+
+	search->grid_ctrl[i][j] = CELL_NOT_USED;
+	search->path_len--;
+
+	return ret_code;
+}
+
+/***********************************************************************************************************************
+ *                                                                                                                     *
+ * FUNCTION: collectSearchPath                                                                                         *
+ *                                                                                                                     *
+ * DESCRIPTION: path search found function - add the word ID of the current path (if it is a word) to the found words  *
+ *              of the parallel search worker                                                                          *
+ *                                                                                                                     *
+ * PARAMETERS: words_grid - (in) pointer to words grid                                                                 *
+ *             search - (in) path search state (of a worker)                                                           *
+ *             char_node - (in) character node of the last path character                                              *
+ *                                                                                                                     *
+ * RETURN: RC_NO_ERROR - no error                                                                                      *
+ *         RC_NO_MEM - no memory                                                                                       *
+ *                                                                                                                     *
+ * NOTES:                                                                                                              *
+ *                                                                                                                     *
+ ***********************************************************************************************************************/
+static RETURN_CODE collectSearchPath (WordsGrid *words_grid, PathSearch *search, CharNode *char_node)
+{
+	SearchWorker *worker = search->worker;
+	unsigned int *word_ids;
+	size_t allocated;
+
+	if (!isRulesWord(words_grid, char_node, search->path_len))
+	{
+		return RC_NO_ERROR;
+	}
+
+	if (worker->no_of_word_ids == worker->allocated_word_ids)
+	{
+		allocated = (worker->allocated_word_ids == 0)? 256: (2 * worker->allocated_word_ids);
+		word_ids = (unsigned int*)realloc(worker->word_ids, allocated * sizeof(unsigned int));
+		if (word_ids == NULL)
+		{
+			return RC_NO_MEM;
+		}
+		worker->word_ids = word_ids;
+		worker->allocated_word_ids = allocated;
+	}
+
+	worker->word_ids[worker->no_of_word_ids++] = char_node->word_id;
+
+	return RC_NO_ERROR;
+}
+
+/***********************************************************************************************************************
+ *                                                                                                                     *
+ * FUNCTION: claimSearchTask                                                                                           *
+ *                                                                                                                     *
+ * DESCRIPTION: claim a task to run - the first task of the worker range, or else the last task of another worker      *
+ *              range (steal)                                                                                          *
+ *                                                                                                                     *
+ * PARAMETERS: worker - (in/out) pointer to parallel search worker                                                     *
+ *                                                                                                                     *
+ * RETURN: task index (or -1 if no task is left)                                                                       *
+ *                                                                                                                     *
+ * NOTES: a range is claimed from by compare and swap of both its ends - a task is claimed by one worker only          *
+ *                                                                                                                     *
+ ***********************************************************************************************************************/
+static long claimSearchTask (SearchWorker *worker)
+{
+	ParallelSearch *parallel = worker->parallel;
+	SearchWorker *victim;
+	unsigned long long range, first, last;
+	int k;
+
+	range = atomic_load(&(worker->task_range));
+	while ((first = (range & 0xFFFFFFFFull)) < (last = (range >> 32)))
+	{
+		if (atomic_compare_exchange_weak(&(worker->task_range), &range, (last << 32) | (first + 1)))
+		{
+			return (long)first;
+		}
+	}
+
+	for (k = 1; k < parallel->no_of_workers; k++)
+	{
+		victim = &(parallel->workers[(worker->index + k) % parallel->no_of_workers]);
+
+		range = atomic_load(&(victim->task_range));
+		while ((first = (range & 0xFFFFFFFFull)) < (last = (range >> 32)))
+		{
+			if (atomic_compare_exchange_weak(&(victim->task_range), &range, ((last - 1) << 32) | first))
+			{
+				return (long)(last - 1);
+			}
+		}
+	}
+
+	return -1;
+}
+
+/***********************************************************************************************************************
+ *                                                                                                                     *
+ * FUNCTION: runSearchTask                                                                                             *
+ *                                                                                                                     *
+ * DESCRIPTION: collect the found words of a parallel search task                                                      *
+ *                                                                                                                     *
+ * PARAMETERS: worker - (in/out) pointer to parallel search worker                                                     *
+ *             search - (in/out) path search state of the worker (no current path)                                     *
+ *             task - (in/out) pointer to task                                                                         *
+ *                                                                                                                     *
+ * RETURN: none (search->ret_code is set on error)                                                                     *
+ *                                                                                                                     *
+ * NOTES:                                                                                                              *
+ *                                                                                                                     *
+ ***********************************************************************************************************************/
+static void runSearchTask (SearchWorker *worker, PathSearch *search, SearchTask *task)
+{
+	int k, last = task->path_len - 1;
+
+	task->worker = worker->index;
+	task->first_word = worker->no_of_word_ids;
+
+	if (task->subtree)
+	{
+		for (k = 0; k < last; k++)
+		{
+			search->path[k] = task->path[k];
+			search->grid_ctrl[task->path[k] / GRID_Y_LEN][task->path[k] % GRID_Y_LEN] = CELL_USED;
+		}
+		search->path_len = last;
+
+		searchPathsFromNode(worker->parallel->words_grid, search, task->char_node, task->path[last] / GRID_Y_LEN, task->path[last] % GRID_Y_LEN);
+
+		for (k = 0; k < last; k++)
+		{
+			search->grid_ctrl[task->path[k] / GRID_Y_LEN][task->path[k] % GRID_Y_LEN] = CELL_NOT_USED;
+		}
+		search->path_len = 0;
+	}
+	else
+	{
+		search->path_len = task->path_len;
+		search->ret_code = collectSearchPath(worker->parallel->words_grid, search, task->char_node);
+		search->path_len = 0;
+	}
+
+	task->no_of_words = worker->no_of_word_ids - task->first_word;
+}
+
+/***********************************************************************************************************************
+ *                                                                                                                     *
+ * FUNCTION: searchWorkerThread                                                                                        *
+ *                                                                                                                     *
+ * DESCRIPTION: parallel search worker thread - runs tasks until no task is left (or on error)                         *
+ *                                                                                                                     *
+ * PARAMETERS: worker - (in/out) pointer to parallel search worker                                                     *
+ *                                                                                                                     *
+ * RETURN: NULL                                                                                                        *
+ *                                                                                                                     *
+ * NOTES: worker->ret_code is set                                                                                      *
+ *                                                                                                                     *
+ ***********************************************************************************************************************/
+static void* searchWorkerThread (void *worker)
+{
+	SearchWorker *search_worker = (SearchWorker*)worker;
+	PathSearch search;
+	long task;
+
+	initGridCtrl(search.grid_ctrl, GRID_X_LEN);
+	search.found_func = collectSearchPath;
+	search.path_len = 0;
+	search.delta = NULL;
+	search.symmetry = 0;
+	search.builder = NULL;
+	search.worker = search_worker;
+	search.ret_code = RC_NO_ERROR;
+
+	while ((search.ret_code == RC_NO_ERROR) && ((task = claimSearchTask(search_worker)) >= 0))
+	{
+		runSearchTask(search_worker, &search, &(search_worker->parallel->tasks[task]));
+	}
+
+	search_worker->ret_code = search.ret_code;
+
+	return NULL;
+}
+
+/***********************************************************************************************************************
+ *                                                                                                                     *
+ * FUNCTION: growGameResult                                                                                            *
+ *                                                                                                                     *
+ * DESCRIPTION: make room in a game result for one more word (of a word ID) and its path cells                         *
+ *                                                                                                                     *
+ * PARAMETERS: game_result - (in/out) pointer to game result                                                           *
+ *             word_id - (in) word ID of the word                                                                      *
+ *             no_of_cells - (in) number of path cells of the word (0 if paths are not returned)                       *
+ *                                                                                                                     *
+ * RETURN: RC_NO_ERROR - no error                                                                                      *
+ *         RC_NO_MEM - no memory                                                                                       *
+ *                                                                                                                     *
+ * NOTES: the arrays grow by doubling and are kept for the next solve                                                  *
+ *                                                                                                                     *
+ ***********************************************************************************************************************/
+static RETURN_CODE growGameResult (GameResult *game_result, unsigned int word_id, size_t no_of_cells)
+{
+	GameWord *words;
+	CellIndex *cells;
+	unsigned int *word_marks;
+	size_t allocated;
+
+	if (word_id >= game_result->allocated_word_marks)
+	{
+		allocated = (game_result->allocated_word_marks == 0)? 4096: game_result->allocated_word_marks;
+		while (allocated <= word_id)
+		{
+			allocated *= 2;
+		}
+		word_marks = (unsigned int*)realloc(game_result->word_marks, allocated * sizeof(unsigned int));
+		if (word_marks == NULL)
+		{
+			return RC_NO_MEM;
+		}
+		memset(word_marks + game_result->allocated_word_marks, 0, (allocated - game_result->allocated_word_marks) * sizeof(unsigned int));
+		game_result->word_marks = word_marks;
+		game_result->allocated_word_marks = allocated;
+	}
+
+	if (game_result->no_of_words == game_result->allocated_words)
+	{
+		allocated = (game_result->allocated_words == 0)? 256: (2 * game_result->allocated_words);
+		words = (GameWord*)realloc(game_result->words, allocated * sizeof(GameWord));
+		if (words == NULL)
+		{
+			return RC_NO_MEM;
+		}
+		game_result->words = words;
+		game_result->allocated_words = allocated;
+	}
+
+	if ((game_result->no_of_cells + no_of_cells) > game_result->allocated_cells)
+	{
+		allocated = (game_result->allocated_cells == 0)? 2048: (2 * game_result->allocated_cells);
+		cells = (CellIndex*)realloc(game_result->cells, allocated * sizeof(CellIndex));
+		if (cells == NULL)
+		{
+			return RC_NO_MEM;
+		}
+		game_result->cells = cells;
+		game_result->allocated_cells = allocated;
+	}
+
+	return RC_NO_ERROR;
+}
+
+/***********************************************************************************************************************
+ *                                                                                                                     *
+ * FUNCTION: addGameWord                                                                                               *
+ *                                                                                                                     *
+ * DESCRIPTION: path search found function - add the current path to the words grid game result if it is a word by     *
+ *              the game rules not found yet by the solve (and add its score to the total score)                       *
+ *                                                                                                                     *
+ * PARAMETERS: words_grid - (in/out) pointer to words grid                                                             *
+ *             search - (in) path search state                                                                         *
+ *             char_node - (in) character node of the last path character                                              *
+ *                                                                                                                     *
+ * RETURN: RC_NO_ERROR - no error                                                                                      *
+ *         RC_NO_MEM - no memory                                                                                       *
+ *                                                                                                                     *
+ * NOTES:                                                                                                              *
+ *                                                                                                                     *
+ ***********************************************************************************************************************/
+static RETURN_CODE addGameWord (WordsGrid *words_grid, PathSearch *search, CharNode *char_node)
+{
+	GameResult *game_result = &(words_grid->game_result);
+	GameWord *game_word;
+	size_t no_of_cells;
+
+	if (!isRulesWord(words_grid, char_node, search->path_len) ||
+		((char_node->word_id < game_result->allocated_word_marks) && (game_result->word_marks[char_node->word_id] == game_result->solve_mark)))
+	{
+		return RC_NO_ERROR;
+	}
+
+	no_of_cells = words_grid->rules.return_paths? (size_t)search->path_len: 0;
+	if (growGameResult(game_result, char_node->word_id, no_of_cells) != RC_NO_ERROR)
+	{
+		return RC_NO_MEM;
+	}
+
+	game_result->word_marks[char_node->word_id] = game_result->solve_mark;
+
+	game_word = &(game_result->words[game_result->no_of_words++]);
+	game_word->word_id = char_node->word_id;
+	game_word->path_offset = (unsigned int)game_result->no_of_cells;
+	game_word->path_len = (unsigned char)search->path_len;
+	game_word->score = words_grid->rules.scores[search->path_len];
+
+	memcpy(game_result->cells + game_result->no_of_cells, search->path, no_of_cells * sizeof(CellIndex));
+	game_result->no_of_cells += no_of_cells;
+	game_result->score += game_word->score;
+
+	return RC_NO_ERROR;
+}
+
+/*******************************************************************************************************************************************************/
+/************************************************************ external functions definition ************************************************************/
+/*******************************************************************************************************************************************************/
+RETURN_CODE WordsGrid_InitWordList (WordsGrid *words_grid, FILE *file)
+{
+	return WordsGrid_LoadWordList(words_grid, file, 0, NULL);
+}
+
+RETURN_CODE WordsGrid_LoadWordList (WordsGrid *words_grid, FILE *file, unsigned int load_flags, WordListLoadStats *stats)
+{
+	initResultSet(&(words_grid->result_set));
+	words_grid->output_id_func = NULL;
+	words_grid->delta_func = NULL;
+	words_grid->path_output_func = NULL;
+	words_grid->grid_cache = NULL;
+	memset(words_grid->grid, 0, sizeof(words_grid->grid));
+	words_grid->symmetry = 0;
+	words_grid->rack_index = NULL;
+	words_grid->grid_mask = 0;
+	words_grid->overlay = NULL;
+	memset(&(words_grid->game_result), 0, sizeof(GameResult));
+	WordsGrid_SetRules(words_grid, NULL);
+
+	return WordList_LoadCharTree(&(words_grid->word_list), file, load_flags, stats);
+}
+
+void WordsGrid_SetGrid (WordsGrid *words_grid, const char *string)
+{
+	int i, j, k = 0;
+	
+	assert(strlen(string) == (GRID_X_LEN*GRID_Y_LEN));
+	
+	for (i = 0; i < GRID_X_LEN; i++)
+	{
+		for (j = 0; j < GRID_Y_LEN; j++)
+		{
+			words_grid->grid[i][j] = string[k++];
+		}
+	}
+
+	words_grid->grid_mask = RackIndex_LetterMask(string);
+	setCanonicalGrid(words_grid);
+}
+
+void WordsGrid_SetOutputFunc (WordsGrid *words_grid, void (*output_func) (char *word))
+{
+	words_grid->output_func = output_func;
+}
+
+void WordsGrid_OutputFoundWords (WordsGrid *words_grid)
+{
+   char grid_ctrl[GRID_X_LEN][GRID_Y_LEN];
+   CharNode *char_node;
+   GridCacheEntry *entry;
+   GridCacheBuilder builder;
+   PathSearch search;
+   int i, j;
+
+   if ((words_grid->grid_cache != NULL) || (words_grid->path_output_func != NULL))
+   {
+	   search.found_func = outputSearchPath;
+	   search.delta = NULL;
+	   search.symmetry = words_grid->symmetry;
+	   search.builder = NULL;
+	   search.worker = NULL;
+
+	   if (words_grid->grid_cache != NULL)
+	   {
+		   /* the paths are kept only if they are output (a hit of word IDs only is output in its entry order) */
+		   entry = GridCache_Find(words_grid->grid_cache, words_grid->canonical_grid, (words_grid->path_output_func != NULL));
+		   if (entry != NULL)
+		   {
+			   outputCachedWords(words_grid, entry);
+			   return;
+		   }
+
+		   GridCache_InitBuilder(&builder, (words_grid->path_output_func != NULL));
+		   search.builder = &builder;
+	   }
+
+	   searchAllPaths(words_grid, &search);
+
+	   if (search.builder != NULL)
+	   {
+		   /* no memory is not an error here - the grid is just not cached */
+		   GridCache_AddEntry(words_grid->grid_cache, &builder, words_grid->canonical_grid, words_grid->symmetry);
+		   GridCache_FreeBuilder(&builder);
+	   }
+	   return;
+   }
+
+   initGridCtrl(grid_ctrl, GRID_X_LEN);
+
+   for (i = 0; i < GRID_X_LEN; i++)
+   {
+	   for (j = 0; j < GRID_Y_LEN; j++)
+	   {
+		   char_node = WordList_FindChar(gridCharTree(words_grid), words_grid->grid[i][j]);
+		   if (char_node != NULL)
+		   {
+			   grid_ctrl[i][j] = CELL_USED;
+			   outputFoundWordsFromPrefix(words_grid, char_node, i, j, grid_ctrl, GRID_X_LEN, 1);
+			   grid_ctrl[i][j] = CELL_NOT_USED;
+		   }
+	   }
+   }
+}
+
+RETURN_CODE WordsGrid_OutputFoundWordsParallel (WordsGrid *words_grid, int no_of_threads)
+{
+	ParallelSearch parallel;
+	SearchWorker *worker;
+	SearchTask *task;
+	PathSearch search;
+	CharNode *char_node;
+	RETURN_CODE ret_code = RC_NO_ERROR;
+	size_t first, last, k;
+	int i, j;
+#ifndef WORDS_GRID_NO_THREADS
+	pthread_t threads[MAX_SEARCH_THREADS];
+	int started[MAX_SEARCH_THREADS] = {0};
+#else
+	no_of_threads = 1;
+#endif
+
+	no_of_threads = (no_of_threads < 1)? 1: ((no_of_threads > MAX_SEARCH_THREADS)? MAX_SEARCH_THREADS: no_of_threads);
+
+	if ((no_of_threads <= 1) || (GRID_CELLS < PARALLEL_MIN_GRID_CELLS) || (words_grid->grid_cache != NULL) ||
+		(words_grid->path_output_func != NULL))
+	{
+		WordsGrid_OutputFoundWords(words_grid);
+		return RC_NO_ERROR;
+	}
+
+	parallel.words_grid = words_grid;
+	parallel.tasks = NULL;
+	parallel.no_of_tasks = 0;
+	parallel.allocated_tasks = 0;
+	parallel.no_of_workers = no_of_threads;
+
+	/* split the search into tasks (in the order of the serial search) */
+	initGridCtrl(search.grid_ctrl, GRID_X_LEN);
+	search.path_len = 0;
+
+	for (i = 0; (i < GRID_X_LEN) && (ret_code == RC_NO_ERROR); i++)
+	{
+		for (j = 0; (j < GRID_Y_LEN) && (ret_code == RC_NO_ERROR); j++)
+		{
+			char_node = WordList_FindChar(gridCharTree(words_grid), words_grid->grid[i][j]);
+			if (char_node != NULL)
+			{
+				ret_code = splitSearchFromNode(&parallel, &search, char_node, i, j);
+			}
+		}
+	}
+
+	/* a thread per SEARCH_TASKS_PER_THREAD tasks at most (the calling thread alone creates no thread) */
+	if ((size_t)no_of_threads * SEARCH_TASKS_PER_THREAD > parallel.no_of_tasks)
+	{
+		no_of_threads = (parallel.no_of_tasks < SEARCH_TASKS_PER_THREAD)? 1: (int)(parallel.no_of_tasks / SEARCH_TASKS_PER_THREAD);
+		parallel.no_of_workers = no_of_threads;
+	}
+
+	/* each worker starts with an equal range of consecutive tasks (the same start cells) */
+	for (k = 0; k < (size_t)no_of_threads; k++)
+	{
+		worker = &(parallel.workers[k]);
+		worker->parallel = &parallel;
+		worker->index = (int)k;
+		worker->word_ids = NULL;
+		worker->no_of_word_ids = 0;
+		worker->allocated_word_ids = 0;
+		worker->ret_code = RC_NO_ERROR;
+
+		first = (ret_code == RC_NO_ERROR)? ((parallel.no_of_tasks * k) / no_of_threads): 0;
+		last = (ret_code == RC_NO_ERROR)? ((parallel.no_of_tasks * (k + 1)) / no_of_threads): 0;
+		atomic_init(&(worker->task_range), ((unsigned long long)last << 32) | first);
+	}
+
+	if (ret_code == RC_NO_ERROR)
+	{
+		/* the calling thread is worker 0 - tasks of a worker whose thread is not created are stolen */
+#ifndef WORDS_GRID_NO_THREADS
+		for (k = 1; k < (size_t)no_of_threads; k++)
+		{
+			started[k] = (pthread_create(&(threads[k]), NULL, searchWorkerThread, &(parallel.workers[k])) == 0);
+		}
+#endif
+		searchWorkerThread(&(parallel.workers[0]));
+#ifndef WORDS_GRID_NO_THREADS
+		for (k = 1; k < (size_t)no_of_threads; k++)
+		{
+			if (started[k])
+			{
+				pthread_join(threads[k], NULL);
+			}
+		}
+#endif
+
+		for (k = 0; k < (size_t)no_of_threads; k++)
+		{
+			if (parallel.workers[k].ret_code != RC_NO_ERROR)
+			{
+				ret_code = parallel.workers[k].ret_code;
+			}
+		}
+	}
+
+	/* merge: the found words of the tasks in task order */
+	for (k = 0; (k < parallel.no_of_tasks) && (ret_code == RC_NO_ERROR); k++)
+	{
+		task = &(parallel.tasks[k]);
+		for (first = 0; first < task->no_of_words; first++)
+		{
+			outputWord(words_grid, parallel.workers[task->worker].word_ids[task->first_word + first]);
+		}
+	}
+
+	for (k = 0; k < (size_t)no_of_threads; k++)
+	{
+		free(parallel.workers[k].word_ids);
+	}
+	free(parallel.tasks);
+
+	return ret_code;
+}
+
+void WordsGrid_SetOutputIdFunc (WordsGrid *words_grid, void (*output_id_func) (unsigned int word_id))
+{
+	words_grid->output_id_func = output_id_func;
+}
+
+void WordsGrid_SetPathOutputFunc (WordsGrid *words_grid, void (*path_output_func) (char *word, CellIndex *path, int path_len))
+{
+	words_grid->path_output_func = path_output_func;
+}
+
+void WordsGrid_SetGridCache (WordsGrid *words_grid, struct _GridCache *grid_cache)
+{
+	words_grid->grid_cache = grid_cache;
+	setCanonicalGrid(words_grid);
+}
+
+void WordsGrid_SetRackIndex (WordsGrid *words_grid, struct _RackIndex *rack_index)
+{
+	assert((rack_index == NULL) || (rack_index->word_list == &(words_grid->word_list)));
+
+	words_grid->rack_index = rack_index;
+}
+
+void WordsGrid_SetDeltaFunc (WordsGrid *words_grid, void (*delta_func) (char *word, int gained))
+{
+	words_grid->delta_func = delta_func;
+}
+
+void WordsGrid_SetOverlay (WordsGrid *words_grid, WordListOverlay *overlay)
+{
+	assert((overlay == NULL) || (overlay->base == &(words_grid->word_list)));
+
+	words_grid->overlay = overlay;
+
+	/* found paths point to character nodes of the previous character tree */
+	clearResultSet(&(words_grid->result_set));
+}
+
+void WordsGrid_BoggleRules (GameRules *rules)
+{
+	static const int boggle_scores[] = { 0, 0, 0, 1, 1, 2, 3, 5, 11 };
+	int k, no_of_scores = (int)(sizeof(boggle_scores) / sizeof(boggle_scores[0]));
+
+	rules->min_len = 3;
+	rules->max_len = MAX_PATH_LEN;
+	rules->return_paths = 1;
+
+	/* words longer than the table are scored as the longest */
+	for (k = 0; k <= MAX_PATH_LEN; k++)
+	{
+		rules->scores[k] = boggle_scores[(k < no_of_scores)? k: (no_of_scores - 1)];
+	}
+}
+
+void WordsGrid_SetRules (WordsGrid *words_grid, const GameRules *rules)
+{
+	if (rules != NULL)
+	{
+		assert((rules->min_len >= 1) && (rules->max_len >= rules->min_len) && (rules->max_len <= MAX_PATH_LEN));
+		words_grid->rules = *rules;
+	}
+	else
+	{
+		WordsGrid_BoggleRules(&(words_grid->rules));
+		words_grid->rules.min_len = 1;
+		words_grid->rules.return_paths = 0;
+	}
+
+	/* the result set words and score are of the previous rules */
+	clearResultSet(&(words_grid->result_set));
+}
+
+RETURN_CODE WordsGrid_Relayout (WordsGrid *words_grid, const unsigned int *layout)
+{
+	assert(words_grid->overlay == NULL);
+
+	/* found paths point to character nodes of the previous layout */
+	clearResultSet(&(words_grid->result_set));
+
+	return WordList_Relayout(&(words_grid->word_list), layout);
+}
+
+RETURN_CODE WordsGrid_Solve (WordsGrid *words_grid)
+{
+	PathSearch search;
+	RETURN_CODE ret_code;
+
+	clearResultSet(&(words_grid->result_set));
+
+	search.found_func = addSearchPath;
+	search.delta = NULL;
+	search.symmetry = 0;
+	search.builder = NULL;
+	search.worker = NULL;
+
+	ret_code = searchAllPaths(words_grid, &search);
+	if (ret_code != RC_NO_ERROR)
+	{
+		clearResultSet(&(words_grid->result_set));
+	}
+
+	return ret_code;
+}
+
+RETURN_CODE WordsGrid_SolveGame (WordsGrid *words_grid)
+{
+	GameResult *game_result = &(words_grid->game_result);
+	PathSearch search;
+	RETURN_CODE ret_code;
+
+	game_result->no_of_words = 0;
+	game_result->no_of_cells = 0;
+	game_result->score = 0;
+
+	/* a new solve mark (the word marks are cleared only when the marks wrap around) */
+	if (++(game_result->solve_mark) == 0)
+	{
+		if (game_result->word_marks != NULL)
+		{
+			memset(game_result->word_marks, 0, game_result->allocated_word_marks * sizeof(unsigned int));
+		}
+		game_result->solve_mark = 1;
+	}
+
+	search.found_func = addGameWord;
+	search.delta = NULL;
+	search.symmetry = 0;
+	search.builder = NULL;
+	search.worker = NULL;
+
+	ret_code = searchAllPaths(words_grid, &search);
+	if (ret_code != RC_NO_ERROR)
+	{
+		game_result->no_of_words = 0;
+		game_result->no_of_cells = 0;
+		game_result->score = 0;
+	}
+
+	return ret_code;
+}
+
+RETURN_CODE WordsGrid_SetCell (WordsGrid *words_grid, int x, int y, char ch, WordsGridDelta *delta)
+{
+	ResultSet *result_set = &(words_grid->result_set);
+	CellIndex cell = (CellIndex)((x * GRID_Y_LEN) + y);
+	FoundPath *found_path;
+	WordCount *word_count;
+	char old_ch;
+	int old_score;
+	size_t k, kept;
+	RETURN_CODE ret_code = RC_NO_ERROR;
+
+	assert((x >= 0) && (x < GRID_X_LEN) && (y >= 0) && (y < GRID_Y_LEN));
+
+	memset(delta, 0, sizeof(WordsGridDelta));
+	old_score = result_set->score;
+	old_ch = words_grid->grid[x][y];
+
+	if (ch != old_ch)
+	{
+		/* 1) drop all paths that pass through the changed cell */
+		result_set->no_of_lost_words = 0;
+		for (k = 0, kept = 0; k < result_set->no_of_found_paths; k++)
+		{
+			found_path = &(result_set->found_paths[k]);
+			if (!pathUsesCell(found_path, cell))
+			{
+				result_set->found_paths[kept++] = *found_path;
+			}
+			else if (isRulesWord(words_grid, found_path->char_node, found_path->path_len))
+			{
+				word_count = findWordCount(result_set, found_path->char_node, 0);
+				assert(word_count && word_count->count);
+
+				if (--(word_count->count) == 0)
+				{
+					result_set->no_of_words--;
+					result_set->score -= words_grid->rules.scores[found_path->path_len];
+					word_count->lost = 1;
+
+					if (addLostWord(result_set, found_path) != RC_NO_ERROR)
+					{
+						ret_code = RC_NO_MEM;
+					}
+				}
+			}
+		}
+		result_set->no_of_found_paths = kept;
+
+		/* 2) search again only the paths that pass through the changed cell */
+		words_grid->grid[x][y] = ch;
+		words_grid->grid_mask = gridLetterMask(words_grid);
+		setCanonicalGrid(words_grid);
+		if (ret_code == RC_NO_ERROR)
+		{
+			ret_code = searchPathsThroughCell(words_grid, x, y, delta);
+		}
+
+		/* 3) dropped words that were not found again are lost */
+		for (k = 0; k < result_set->no_of_lost_words; k++)
+		{
+			found_path = &(result_set->lost_words[k]);
+			word_count = findWordCount(result_set, found_path->char_node, 0);
+			assert(word_count);
+
+			if (word_count->lost)
+			{
+				word_count->lost = 0;
+				delta->words_lost++;
+				if ((words_grid->delta_func != NULL) && (ret_code == RC_NO_ERROR))
+				{
+					words_grid->delta_func(gridWord(words_grid, found_path->char_node->word_id), 0);
+				}
+			}
+		}
+		result_set->no_of_lost_words = 0;
+
+		if (ret_code != RC_NO_ERROR)
+		{
+			clearResultSet(result_set);
+		}
+	}
+
+	delta->score = result_set->score;
+	delta->score_delta = result_set->score - old_score;
+
+	return ret_code;
+}
+
+int WordsGrid_FindWord (WordsGrid *words_grid, char *word, CellIndex *path)
+{
+	if ((word[0] == '\0') || (strlen(word) > MAX_PATH_LEN))
+	{
+		return 0;
+	}
+
+	/* prefilter: all the word letters must be in grid */
+	if (RackIndex_LetterMask(word) & ~words_grid->grid_mask)
+	{
+		return 0;
+	}
+
+	return findWordPath(words_grid, word, path);
+}
+
+int WordsGrid_FindWordId (WordsGrid *words_grid, unsigned int word_id, CellIndex *path)
+{
+	char *word;
+
+	/* prefilter: all the word letters must be in grid (by the word letter mask of the rack index) */
+	if ((words_grid->rack_index != NULL) && (word_id < words_grid->rack_index->word_list->no_of_words) &&
+		(words_grid->rack_index->word_masks[word_id] & ~words_grid->grid_mask))
+	{
+		return 0;
+	}
+
+	word = gridWord(words_grid, word_id);
+	if ((word[0] == '\0') || (strlen(word) > MAX_PATH_LEN))
+	{
+		return 0;
+	}
+
+	/* a base word removed by the overlay is not a word of the searched character tree */
+	if ((words_grid->overlay != NULL) && (WordList_FindWord(gridCharTree(words_grid), word) != WORD_FOUND))
+	{
+		return 0;
+	}
+
+	return findWordPath(words_grid, word, path);
+}
+
+void WordsGrid_ProfileNodes (WordsGrid *words_grid, WordListProfile *profile)
+{
+	size_t k;
+
+	for (k = 0; k < words_grid->result_set.no_of_found_paths; k++)
+	{
+		WordList_ProfileNode(profile, words_grid->result_set.found_paths[k].char_node);
+	}
 }
 
 void WordsGrid_Free (WordsGrid *words_grid)
 {
-	words_grid->word_list.freed_nodes = WordList_FreeCharTree(words_grid->word_list.char_tree);
+	freeResultSet(&(words_grid->result_set));
+	free(words_grid->game_result.words);
+	free(words_grid->game_result.cells);
+	free(words_grid->game_result.word_marks);
+	WordList_Free(&(words_grid->word_list));
 }
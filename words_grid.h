@@ -4,12 +4,154 @@
 #include <stdio.h>
 #include "word_list.h"
 
+/* grid size (e.g. -DGRID_X_LEN=20 -DGRID_Y_LEN=20 for big puzzle grids) */
+#ifndef GRID_X_LEN
 #define GRID_X_LEN		4
+#endif
+#ifndef GRID_Y_LEN
 #define GRID_Y_LEN		4
+#endif
+
+#define GRID_CELLS		(GRID_X_LEN*GRID_Y_LEN)
+
+/* parallel search (WordsGrid_OutputFoundWordsParallel): maximal number of threads and number of steps after the
+   start cell of a search task */
+#define MAX_SEARCH_THREADS		64
+#define SEARCH_TASK_STEPS		2
+
+/* parallel search: a grid of fewer cells is searched serially (creating the threads costs more than its search) and
+   every thread gets at least SEARCH_TASKS_PER_THREAD tasks */
+#ifndef PARALLEL_MIN_GRID_CELLS
+#define PARALLEL_MIN_GRID_CELLS	64
+#endif
+#define SEARCH_TASKS_PER_THREAD	32
 
 #define CELL_NOT_USED	((char)0)
 #define CELL_USED		((char)1)
 
+/* a found word path can not be longer than the number of grid cells nor than the longest word */
+#if (GRID_CELLS < MAX_WORD_LEN)
+#define MAX_PATH_LEN	GRID_CELLS
+#else
+#define MAX_PATH_LEN	MAX_WORD_LEN
+#endif
+
+/* grid cell index: (x * GRID_Y_LEN) + y */
+#if (GRID_CELLS <= 256)
+typedef unsigned char CellIndex;
+#else
+typedef unsigned short CellIndex;
+#endif
+
+/* found path - a path of grid cells that spells a word (or a word prefix) of the word list */
+typedef struct _FoundPath
+{
+	/* character node of the last path character in the word list's character tree */
+	CharNode *char_node;
+
+	unsigned char path_len;
+	CellIndex path[MAX_PATH_LEN];
+
+} FoundPath;
+
+/* number of found paths of one word in a result set (entry of an open addressing hash table) */
+typedef struct _WordCount
+{
+	CharNode *word_node;
+	unsigned int count;
+	unsigned char lost;
+
+} WordCount;
+
+/* result set of a solved grid - kept to re-solve incrementally after single cell changes */
+typedef struct _ResultSet
+{
+	/* all found paths - of words and of word prefixes (prefix paths are extended when a cell next to them changes) */
+	FoundPath *found_paths;
+	size_t no_of_found_paths;
+	size_t allocated_found_paths;
+
+	/* found paths per word (hash table size is a power of 2) */
+	WordCount *word_counts;
+	size_t word_counts_size;
+	size_t word_counts_used;
+
+	/* paths of words lost while applying a cell change */
+	FoundPath *lost_words;
+	size_t no_of_lost_words;
+	size_t allocated_lost_words;
+
+	/* number of distinct found words and their total score */
+	size_t no_of_words;
+	int score;
+
+} ResultSet;
+
+/* result of a single cell change */
+typedef struct _WordsGridDelta
+{
+	size_t words_gained;
+	size_t words_lost;
+
+	int score_delta;
+	int score;
+
+} WordsGridDelta;
+
+/* game rules profile - applied by every search: a path is extended only up to max_len cells and only words of
+   min_len characters or more are found (output, counted and scored) */
+typedef struct _GameRules
+{
+	int min_len;
+	int max_len;
+
+	/* score per word length */
+	int scores[MAX_PATH_LEN+1];
+
+	/* 1 - WordsGrid_SolveGame records the path of every found word, 0 - word IDs and scores only */
+	int return_paths;
+
+} GameRules;
+
+/* found word of a game result */
+typedef struct _GameWord
+{
+	unsigned int word_id;
+
+	/* path of the word: cells[path_offset] .. cells[path_offset + path_len - 1] of the game result (if return_paths) */
+	unsigned int path_offset;
+	unsigned char path_len;
+
+	int score;
+
+} GameWord;
+
+/* game result of the last WordsGrid_SolveGame - every distinct found word once (by its first found path) and the
+   total score; the arrays are kept and reused by the next solve */
+typedef struct _GameResult
+{
+	GameWord *words;
+	size_t no_of_words;
+	size_t allocated_words;
+
+	/* cell arena of the found words paths */
+	CellIndex *cells;
+	size_t no_of_cells;
+	size_t allocated_cells;
+
+	int score;
+
+	/* solve mark per word ID - a word is found by the solve when it has the mark of the solve */
+	unsigned int *word_marks;
+	size_t allocated_word_marks;
+	unsigned int solve_mark;
+
+} GameResult;
+
+/* grid cache (grid_cache.h) and rack index (rack_index.h) */
+struct _GridCache;
+struct _RackIndex;
+
 /* words grid struct */
 typedef struct _WordsGrid
 {
@@ -21,6 +163,38 @@ typedef struct _WordsGrid
 	
 	/* output function to be used for all found words in grid */
 	void (*output_func) (char *word);
+
+	/* output function to be used for all found word IDs in grid (used instead of output_func if set) */
+	void (*output_id_func) (unsigned int word_id);
+
+	/* output function to be used for all found words in grid along with their paths (used instead of output_func if set) */
+	void (*path_output_func) (char *word, CellIndex *path, int path_len);
+
+	/* cache of found words per canonical grid (or NULL) */
+	struct _GridCache *grid_cache;
+
+	/* canonical grid of grid (GridCache_CanonicalGrid) and the symmetry that maps grid to it - set with grid_cache */
+	char canonical_grid[GRID_CELLS];
+	int symmetry;
+
+	/* rack index of word_list whose word letter masks prefilter WordsGrid_FindWordId (or NULL) */
+	struct _RackIndex *rack_index;
+
+	/* letter mask of the grid letters (RackIndex_LetterMask) */
+	unsigned int grid_mask;
+
+	/* result set of the last solve (WordsGrid_Solve / WordsGrid_SetCell) */
+	ResultSet result_set;
+
+	/* delta function to be used for all words gained (gained = 1) or lost (gained = 0) by WordsGrid_SetCell */
+	void (*delta_func) (char *word, int gained);
+
+	/* word list overlay of word_list to search words of instead of word_list (NULL for word_list) */
+	WordListOverlay *overlay;
+
+	/* game rules of all searches and the result of the last WordsGrid_SolveGame */
+	GameRules rules;
+	GameResult game_result;
 	
 } WordsGrid;
 
@@ -43,6 +217,27 @@ typedef struct _WordsGrid
  ***********************************************************************************************************************/
 RETURN_CODE WordsGrid_InitWordList (WordsGrid *words_grid, FILE *file);
 
+/***********************************************************************************************************************
+ *                                                                                                                     *
+ * FUNCTION: WordsGrid_LoadWordList                                                                                    *
+ *                                                                                                                     *
+ * DESCRIPTION: initialise word list in words grid from a raw word list file normalized by load flags                  *
+ *              (WordList_LoadCharTree)                                                                                *
+ *                                                                                                                     *
+ * PARAMETERS: words_grid - (in/out) pointer to words grid to initialise its word list                                 *
+ *             file - (in) pointer to (already open) input file to read word list from                                 *
+ *             load_flags - (in) LOAD_xxx flags (e.g. LOAD_NORMALIZE)                                                  *
+ *             stats - (out) pointer to load statistics (or NULL)                                                      *
+ *                                                                                                                     *
+ * RETURN:    RC_BAD_FORMAT - file format error                                                                        *
+ *            RC_NO_MEM - no memory                                                                                    *
+ *            RC_EOF - no error (end of file)                                                                          *
+ *                                                                                                                     *
+ * NOTES:                                                                                                              *
+ *                                                                                                                     *
+ ***********************************************************************************************************************/
+RETURN_CODE WordsGrid_LoadWordList (WordsGrid *words_grid, FILE *file, unsigned int load_flags, WordListLoadStats *stats);
+
 /***********************************************************************************************************************
  *                                                                                                                     *
  * FUNCTION: WordsGrid_SetGrid                                                                                         *
@@ -75,6 +270,22 @@ void WordsGrid_SetGrid (WordsGrid *words_grid, const char *string);
  ***********************************************************************************************************************/
 void WordsGrid_SetOutputFunc (WordsGrid *words_grid, void (*output_func) (char *word));
 
+/***********************************************************************************************************************
+ *                                                                                                                     *
+ * FUNCTION: WordsGrid_SetOutputIdFunc                                                                                 *
+ *                                                                                                                     *
+ * DESCRIPTION: set word ID output function in words grid                                                              *
+ *                                                                                                                     *
+ * PARAMETERS: words_grid - (in/out) pointer to words grid to set its output_id_func                                   *
+ *             output_id_func - (in) pointer to word ID output function (or NULL to output word strings)               *
+ *                                                                                                                     *
+ * RETURN: none                                                                                                        *
+ *                                                                                                                     *
+ * NOTES: word strings can be looked up by WordList_GetWord                                                            *
+ *                                                                                                                     *
+ ***********************************************************************************************************************/
+void WordsGrid_SetOutputIdFunc (WordsGrid *words_grid, void (*output_id_func) (unsigned int word_id));
+
 /***********************************************************************************************************************
  *                                                                                                                     *
  * FUNCTION: WordsGrid_OutputFoundWords                                                                                *
@@ -86,10 +297,284 @@ void WordsGrid_SetOutputFunc (WordsGrid *words_grid, void (*output_func) (char *
  * RETURN: none                                                                                                        *
  *                                                                                                                     *
  * NOTES: must be called only after WordsGrid_SetGrid, WordsGrid_SetGrid and WordsGrid_SetOutputFunc                   *
+ *        with a grid cache set, found words of a grid already solved (or of any of its rotations/reflections) are     *
+ *        output from the cache - in the same order as by a search of the grid; with no path output function set,      *
+ *        only word IDs are cached and a rotation/reflection outputs the words in the search order of the solved grid  *
  *                                                                                                                     *
  ***********************************************************************************************************************/
 void WordsGrid_OutputFoundWords (WordsGrid *words_grid);
 
+/***********************************************************************************************************************
+ *                                                                                                                     *
+ * FUNCTION: WordsGrid_OutputFoundWordsParallel                                                                        *
+ *                                                                                                                     *
+ * DESCRIPTION: output (using output function) found words from word list in grid - the search of the grid is split    *
+ *              between threads (for the latency of one big grid)                                                      *
+ *                                                                                                                     *
+ * PARAMETERS: words_grid - (in) pointer to words grid                                                                 *
+ *             no_of_threads - (in) maximal number of threads (clamped to 1 .. MAX_SEARCH_THREADS)                     *
+ *                                                                                                                     *
+ * RETURN: RC_NO_ERROR - no error                                                                                      *
+ *         RC_NO_MEM - no memory (no word is output)                                                                   *
+ *                                                                                                                     *
+ * NOTES: words are output by the calling thread, in the order of WordsGrid_OutputFoundWords                           *
+ *        the search is split into tasks - a start cell and its first SEARCH_TASK_STEPS steps - each thread runs a     *
+ *        range of tasks and then steals tasks of the other threads; every thread keeps its found words, which are     *
+ *        merged after all threads are done (no locks)                                                                 *
+ *        solves with WordsGrid_OutputFoundWords if no_of_threads is 1, a grid cache or a path output function is      *
+ *        set, the grid has fewer than PARALLEL_MIN_GRID_CELLS cells (or if built with WORDS_GRID_NO_THREADS)          *
+ *        fewer threads are used if there are not SEARCH_TASKS_PER_THREAD tasks for each thread                        *
+ *                                                                                                                     *
+ ***********************************************************************************************************************/
+RETURN_CODE WordsGrid_OutputFoundWordsParallel (WordsGrid *words_grid, int no_of_threads);
+
+/***********************************************************************************************************************
+ *                                                                                                                     *
+ * FUNCTION: WordsGrid_SetPathOutputFunc                                                                               *
+ *                                                                                                                     *
+ * DESCRIPTION: set path output function in words grid                                                                 *
+ *                                                                                                                     *
+ * PARAMETERS: words_grid - (in/out) pointer to words grid to set its path_output_func                                 *
+ *             path_output_func - (in) pointer to path output function (or NULL to output words only)                  *
+ *                                                                                                                     *
+ * RETURN: none                                                                                                        *
+ *                                                                                                                     *
+ * NOTES:                                                                                                              *
+ *                                                                                                                     *
+ ***********************************************************************************************************************/
+void WordsGrid_SetPathOutputFunc (WordsGrid *words_grid, void (*path_output_func) (char *word, CellIndex *path, int path_len));
+
+/***********************************************************************************************************************
+ *                                                                                                                     *
+ * FUNCTION: WordsGrid_SetGridCache                                                                                    *
+ *                                                                                                                     *
+ * DESCRIPTION: set grid cache in words grid (used by WordsGrid_OutputFoundWords)                                      *
+ *                                                                                                                     *
+ * PARAMETERS: words_grid - (in/out) pointer to words grid to set its grid_cache                                       *
+ *             grid_cache - (in) pointer to (initialised) grid cache (or NULL for no cache)                            *
+ *                                                                                                                     *
+ * RETURN: none                                                                                                        *
+ *                                                                                                                     *
+ * NOTES: a grid cache may be shared by words grids of the same word list                                              *
+ *                                                                                                                     *
+ ***********************************************************************************************************************/
+void WordsGrid_SetGridCache (WordsGrid *words_grid, struct _GridCache *grid_cache);
+
+/***********************************************************************************************************************
+ *                                                                                                                     *
+ * FUNCTION: WordsGrid_SetRackIndex                                                                                    *
+ *                                                                                                                     *
+ * DESCRIPTION: set rack index in words grid (to prefilter WordsGrid_FindWordId by the word letter masks)              *
+ *                                                                                                                     *
+ * PARAMETERS: words_grid - (in/out) pointer to words grid                                                             *
+ *             rack_index - (in) pointer to rack index built of the words grid word list (or NULL for none)            *
+ *                                                                                                                     *
+ * RETURN: none                                                                                                        *
+ *                                                                                                                     *
+ * NOTES:                                                                                                              *
+ *                                                                                                                     *
+ ***********************************************************************************************************************/
+void WordsGrid_SetRackIndex (WordsGrid *words_grid, struct _RackIndex *rack_index);
+
+/***********************************************************************************************************************
+ *                                                                                                                     *
+ * FUNCTION: WordsGrid_SetDeltaFunc                                                                                    *
+ *                                                                                                                     *
+ * DESCRIPTION: set delta function in words grid                                                                       *
+ *                                                                                                                     *
+ * PARAMETERS: words_grid - (in/out) pointer to words grid to set its delta_func                                       *
+ *             delta_func - (in) pointer to delta function (or NULL for counting and scoring only)                     *
+ *                                                                                                                     *
+ * RETURN: none                                                                                                        *
+ *                                                                                                                     *
+ * NOTES:                                                                                                              *
+ *                                                                                                                     *
+ ***********************************************************************************************************************/
+void WordsGrid_SetDeltaFunc (WordsGrid *words_grid, void (*delta_func) (char *word, int gained));
+
+/***********************************************************************************************************************
+ *                                                                                                                     *
+ * FUNCTION: WordsGrid_SetOverlay                                                                                      *
+ *                                                                                                                     *
+ * DESCRIPTION: set word list overlay in words grid (words of the overlay are searched instead of the word list)       *
+ *                                                                                                                     *
+ * PARAMETERS: words_grid - (in/out) pointer to words grid to set its overlay                                          *
+ *             overlay - (in) pointer to word list overlay of the words grid word list (or NULL for the word list)     *
+ *                                                                                                                     *
+ * RETURN: none                                                                                                        *
+ *                                                                                                                     *
+ * NOTES: clears the result set (WordsGrid_Solve must be called before WordsGrid_SetCell) - and so must be called      *
+ *        again after the overlay is changed; a grid cache holds results of one word list or overlay only              *
+ *                                                                                                                     *
+ ***********************************************************************************************************************/
+void WordsGrid_SetOverlay (WordsGrid *words_grid, WordListOverlay *overlay);
+
+/***********************************************************************************************************************
+ *                                                                                                                     *
+ * FUNCTION: WordsGrid_BoggleRules                                                                                     *
+ *                                                                                                                     *
+ * DESCRIPTION: Boggle game rules - words of 3 letters or more, scored 1, 1, 2, 3, 5 and 11 for 8 letters or more,     *
+ *              with their paths                                                                                       *
+ *                                                                                                                     *
+ * PARAMETERS: rules - (out) pointer to game rules                                                                     *
+ *                                                                                                                     *
+ * RETURN: none                                                                                                        *
+ *                                                                                                                     *
+ * NOTES:                                                                                                              *
+ *                                                                                                                     *
+ ***********************************************************************************************************************/
+void WordsGrid_BoggleRules (GameRules *rules);
+
+/***********************************************************************************************************************
+ *                                                                                                                     *
+ * FUNCTION: WordsGrid_SetRules                                                                                        *
+ *                                                                                                                     *
+ * DESCRIPTION: set the game rules of words grid                                                                       *
+ *                                                                                                                     *
+ * PARAMETERS: words_grid - (in/out) pointer to words grid                                                             *
+ *             rules - (in) pointer to game rules (copied) or NULL for the default rules: words of any length, Boggle  *
+ *                     scoring and no paths                                                                            *
+ *                                                                                                                     *
+ * RETURN: none                                                                                                        *
+ *                                                                                                                     *
+ * NOTES: clears the result set (WordsGrid_Solve must be called before WordsGrid_SetCell); a grid cache holds results  *
+ *        of one rules profile only                                                                                    *
+ *                                                                                                                     *
+ ***********************************************************************************************************************/
+void WordsGrid_SetRules (WordsGrid *words_grid, const GameRules *rules);
+
+/***********************************************************************************************************************
+ *                                                                                                                     *
+ * FUNCTION: WordsGrid_Relayout                                                                                        *
+ *                                                                                                                     *
+ * DESCRIPTION: lay the words grid word list character nodes out in one node arena in a given order                    *
+ *              (WordList_Relayout)                                                                                    *
+ *                                                                                                                     *
+ * PARAMETERS: words_grid - (in/out) pointer to words grid                                                             *
+ *             layout - (in) node layout (e.g. by WordList_ProfileLayout or WordList_LoadLayout) or NULL for level     *
+ *                      order                                                                                          *
+ *                                                                                                                     *
+ * RETURN: RC_NO_ERROR - no error                                                                                      *
+ *         RC_BAD_FORMAT - layout is not an order of all nodes                                                         *
+ *         RC_NO_MEM - no memory                                                                                       *
+ *                                                                                                                     *
+ * NOTES: clears the result set (WordsGrid_Solve must be called before WordsGrid_SetCell); must not be called while    *
+ *        an overlay is set (overlays of the word list must be created after the relayout)                             *
+ *                                                                                                                     *
+ ***********************************************************************************************************************/
+RETURN_CODE WordsGrid_Relayout (WordsGrid *words_grid, const unsigned int *layout);
+
+/***********************************************************************************************************************
+ *                                                                                                                     *
+ * FUNCTION: WordsGrid_Solve                                                                                           *
+ *                                                                                                                     *
+ * DESCRIPTION: find all words from word list in grid and keep them (and the grid cells each of them uses) in the      *
+ *              words grid result set                                                                                  *
+ *                                                                                                                     *
+ * PARAMETERS: words_grid - (in/out) pointer to words grid                                                             *
+ *                                                                                                                     *
+ * RETURN: RC_NO_ERROR - no error                                                                                      *
+ *         RC_NO_MEM - no memory (result set is left empty)                                                            *
+ *                                                                                                                     *
+ * NOTES: must be called only after WordsGrid_InitWordList and WordsGrid_SetGrid                                       *
+ *        the total score is result_set.score: every distinct word is scored once by its length (game rules)           *
+ *                                                                                                                     *
+ ***********************************************************************************************************************/
+RETURN_CODE WordsGrid_Solve (WordsGrid *words_grid);
+
+/***********************************************************************************************************************
+ *                                                                                                                     *
+ * FUNCTION: WordsGrid_SolveGame                                                                                       *
+ *                                                                                                                     *
+ * DESCRIPTION: find all words from word list in grid by the game rules into the words grid game result - each         *
+ *              distinct word once with its score (and path if return_paths) and the total score                       *
+ *                                                                                                                     *
+ * PARAMETERS: words_grid - (in/out) pointer to words grid                                                             *
+ *                                                                                                                     *
+ * RETURN: RC_NO_ERROR - no error                                                                                      *
+ *         RC_NO_MEM - no memory (game result is left empty)                                                           *
+ *                                                                                                                     *
+ * NOTES: must be called only after WordsGrid_InitWordList and WordsGrid_SetGrid                                       *
+ *        words are in the order of the search; the game result is valid until the next WordsGrid_SolveGame            *
+ *                                                                                                                     *
+ ***********************************************************************************************************************/
+RETURN_CODE WordsGrid_SolveGame (WordsGrid *words_grid);
+
+/***********************************************************************************************************************
+ *                                                                                                                     *
+ * FUNCTION: WordsGrid_SetCell                                                                                         *
+ *                                                                                                                     *
+ * DESCRIPTION: change one grid cell and re-solve incrementally: only the paths that pass through the changed cell     *
+ *              are dropped from the result set and searched again (extending the kept prefix paths that end next      *
+ *              to the changed cell)                                                                                   *
+ *                                                                                                                     *
+ * PARAMETERS: words_grid - (in/out) pointer to words grid                                                             *
+ *             x,y - (in) the indices of the cell to change                                                            *
+ *             ch - (in) new character of the cell                                                                     *
+ *             delta - (out) number of words gained and lost, and the updated total score                              *
+ *                                                                                                                     *
+ * RETURN: RC_NO_ERROR - no error                                                                                      *
+ *         RC_NO_MEM - no memory (result set is left empty)                                                            *
+ *                                                                                                                     *
+ * NOTES: must be called only after WordsGrid_Solve                                                                    *
+ *        words gained and lost are output (after the change) using delta function (if set)                            *
+ *                                                                                                                     *
+ ***********************************************************************************************************************/
+RETURN_CODE WordsGrid_SetCell (WordsGrid *words_grid, int x, int y, char ch, WordsGridDelta *delta);
+
+/***********************************************************************************************************************
+ *                                                                                                                     *
+ * FUNCTION: WordsGrid_FindWord                                                                                        *
+ *                                                                                                                     *
+ * DESCRIPTION: find a word (of any word list) in grid                                                                 *
+ *                                                                                                                     *
+ * PARAMETERS: words_grid - (in) pointer to words grid                                                                 *
+ *             word - (in) word to find                                                                                *
+ *             path - (out) grid cells of the word (MAX_PATH_LEN cells)                                                *
+ *                                                                                                                     *
+ * RETURN: path length (0 if the word is not in grid)                                                                  *
+ *                                                                                                                     *
+ * NOTES: a word with a letter not in grid is rejected by its letter mask (rack_index.h) with no path search           *
+ *                                                                                                                     *
+ ***********************************************************************************************************************/
+int WordsGrid_FindWord (WordsGrid *words_grid, char *word, CellIndex *path);
+
+/***********************************************************************************************************************
+ *                                                                                                                     *
+ * FUNCTION: WordsGrid_FindWordId                                                                                      *
+ *                                                                                                                     *
+ * DESCRIPTION: find a word of the words grid word list (or of its overlay, if set) by its word ID in grid             *
+ *                                                                                                                     *
+ * PARAMETERS: words_grid - (in) pointer to words grid                                                                 *
+ *             word_id - (in) word ID of the word to find                                                              *
+ *             path - (out) grid cells of the word (MAX_PATH_LEN cells)                                                *
+ *                                                                                                                     *
+ * RETURN: path length (0 if the word is not in grid)                                                                  *
+ *                                                                                                                     *
+ * NOTES: with a rack index set, a word with a letter not in grid is rejected by the letter mask of its word ID (one   *
+ *        AND, the word string is not read) with no path search; a base word removed by the overlay is not found       *
+ *                                                                                                                     *
+ ***********************************************************************************************************************/
+int WordsGrid_FindWordId (WordsGrid *words_grid, unsigned int word_id, CellIndex *path);
+
+/***********************************************************************************************************************
+ *                                                                                                                     *
+ * FUNCTION: WordsGrid_ProfileNodes                                                                                    *
+ *                                                                                                                     *
+ * DESCRIPTION: count the character nodes of all found paths (of words and of word prefixes) of the last solve in a    *
+ *              word list profile - the nodes a grid search visits and finds                                           *
+ *                                                                                                                     *
+ * PARAMETERS: words_grid - (in) pointer to words grid                                                                 *
+ *             profile - (in/out) pointer to profile of the words grid word list (WordList_InitProfile)                *
+ *                                                                                                                     *
+ * RETURN: none                                                                                                        *
+ *                                                                                                                     *
+ * NOTES: must be called only after WordsGrid_Solve; profile a sample of grids, then WordList_ProfileLayout and        *
+ *        WordsGrid_Relayout                                                                                           *
+ *                                                                                                                     *
+ ***********************************************************************************************************************/
+void WordsGrid_ProfileNodes (WordsGrid *words_grid, WordListProfile *profile);
+
 /***********************************************************************************************************************
  *                                                                                                                     *
  * FUNCTION: WordsGrid_Free                                                                                            *